@@ -1,38 +1,17 @@
 #include <iostream>
 #include <string>
 #include <random>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
 #include <core/moves.hpp>
 
 #include "core/field.hpp"
+#include "core/field_hash_set.hpp"
 #include "core/srs.hpp"
 #include "core/types.hpp"
 #include "finder/perfect.hpp"
-
-template<int N>
-std::array<core::PieceType, N> toPieces(int value) {
-    int arr[N];
-
-    for (int index = N - 1; 0 <= index; --index) {
-        int scale = 7 - index;
-        arr[index] = value % scale;
-        value /= scale;
-    }
-
-    for (int select = N - 2; 0 <= select; --select) {
-        for (int adjust = select + 1; adjust < N; ++adjust) {
-            if (arr[select] <= arr[adjust]) {
-                arr[adjust] += 1;
-            }
-        }
-    }
-
-    std::array<core::PieceType, N> pieces = {};
-    for (int index = 0; index < N; ++index) {
-        pieces[index] = static_cast<core::PieceType>(arr[index]);
-    }
-
-    return pieces;
-}
+#include "finder/sequence_space.hpp"
 
 void benchmark() {
     using namespace std::literals::string_literals;
@@ -68,11 +47,9 @@ void benchmark() {
 
     int success = 0;
     long long int totalTime = 0L;
-    int max = 5040;
-    for (int value = 0; value < max; ++value) {
-        auto arr = toPieces<maxDepth>(value);
-        auto pieces = std::vector(arr.begin(), arr.end());
-
+    auto space = finder::SequenceSpace::createPermutations(maxDepth);
+    auto max = space.size();
+    space.forEach([&](int64_t value, const finder::Sequence &pieces) {
         auto start2 = std::chrono::system_clock::now();
 
         auto result = finder.run(field, pieces, maxDepth, maxLine, false);
@@ -95,13 +72,156 @@ void benchmark() {
 
         auto elapsed = std::chrono::system_clock::now() - start2;
         totalTime += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
-    }
+    });
 
     std::cout << "success: " << success << std::endl;
 
     std::cout << totalTime / static_cast<double>(max) << " milli seconds" << std::endl;
 }
 
+// Inserts the fields after up to 3 placements, which contain many duplicates
+void benchmarkFieldHashSet() {
+    using namespace std::literals::string_literals;
+
+    auto field = core::createField(
+            "XX________"s +
+            "XX________"s +
+            "XXX______X"s +
+            "XXXXXXX__X"s +
+            "XXXXXX___X"s +
+            "XXXXXXX_XX"s +
+            ""
+    );
+
+    auto factory = core::Factory::create();
+    auto moveGenerator = core::srs::MoveGenerator(factory);
+
+    std::vector<core::Field> fields{};
+    std::vector<core::Field> current{field};
+    for (int depth = 0; depth < 3; ++depth) {
+        std::vector<core::Field> next{};
+        std::vector<core::Move> moves{};
+        for (const auto &parent : current) {
+            for (int piece = 0; piece < 7; ++piece) {
+                auto pieceType = static_cast<core::PieceType>(piece);
+
+                moves.clear();
+                moveGenerator.search(moves, parent, pieceType, 6);
+                for (const auto &move : moves) {
+                    auto freeze = core::Field(parent);
+                    freeze.put(factory.get(pieceType, move.rotateType), move.x, move.y);
+                    freeze.clearLine();
+                    next.push_back(freeze);
+                }
+            }
+        }
+        fields.insert(fields.end(), next.begin(), next.end());
+        current = std::move(next);
+    }
+
+    std::cout << "# Fields: " << fields.size() << std::endl;
+
+    auto measure = [&](const std::string &name, auto &&insertAll) {
+        auto start = std::chrono::system_clock::now();
+        size_t size = insertAll();
+        auto elapsed = std::chrono::system_clock::now() - start;
+        auto time = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        std::cout << name << ": " << size << " unique, " << time << " micro seconds" << std::endl;
+    };
+
+    measure("std::unordered_set", [&]() {
+        auto set = std::unordered_set<core::Field>{};
+        for (const auto &field : fields) {
+            set.insert(field);
+        }
+        return set.size();
+    });
+
+    measure("FieldHashSet", [&]() {
+        auto set = core::FieldHashSet(fields.size());
+        for (const auto &field : fields) {
+            set.insert(field);
+        }
+        return set.size();
+    });
+
+    auto numOfThreads = std::max(1U, std::thread::hardware_concurrency());
+    measure("ConcurrentFieldHashSet (" + std::to_string(numOfThreads) + " threads)", [&]() {
+        auto set = core::ConcurrentFieldHashSet(fields.size());
+        std::vector<std::thread> threads{};
+        for (unsigned int thread = 0; thread < numOfThreads; ++thread) {
+            threads.emplace_back([&, thread]() {
+                for (size_t index = thread; index < fields.size(); index += numOfThreads) {
+                    set.insert(fields[index]);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return set.size();
+    });
+}
+
+// Compares the move generators on fields with and without overhangs
+void benchmarkMoveGenerator() {
+    auto factory = core::Factory::create();
+    auto random = std::mt19937(0);
+
+    std::vector<core::Field> flatFields{};
+    std::vector<core::Field> overhangFields{};
+    for (int count = 0; count < 2000; ++count) {
+        // Columns filled up to random heights
+        auto flat = core::Field{};
+        for (int x = 0; x < core::FIELD_WIDTH; ++x) {
+            int height = static_cast<int>(random() % 8);
+            for (int y = 0; y < height; ++y) {
+                flat.setBlock(x, y);
+            }
+        }
+        flatFields.push_back(flat);
+
+        // Random blocks that get sparse toward the top
+        auto overhang = core::Field{};
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < core::FIELD_WIDTH; ++x) {
+                if (static_cast<int>(random() % 10) < 8 - y) {
+                    overhang.setBlock(x, y);
+                }
+            }
+        }
+        overhangFields.push_back(overhang);
+    }
+
+    auto measure = [&](const std::string &name, const std::vector<core::Field> &fields, auto &moveGenerator) {
+        std::vector<core::Move> moves{};
+        size_t total = 0;
+
+        auto start = std::chrono::system_clock::now();
+        for (const auto &field : fields) {
+            for (int piece = 0; piece < 7; ++piece) {
+                moves.clear();
+                moveGenerator.search(moves, field, static_cast<core::PieceType>(piece), 12);
+                total += moves.size();
+            }
+        }
+        auto elapsed = std::chrono::system_clock::now() - start;
+        auto time = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        std::cout << name << ": " << total << " moves, " << time << " micro seconds" << std::endl;
+    };
+
+    auto srs = core::srs::MoveGenerator(factory);
+    auto iterative = core::srs_iterative::MoveGenerator(factory);
+
+    std::cout << "# Without overhangs" << std::endl;
+    measure("srs", flatFields, srs);
+    measure("srs_iterative", flatFields, iterative);
+
+    std::cout << "# With overhangs" << std::endl;
+    measure("srs", overhangFields, srs);
+    measure("srs_iterative", overhangFields, iterative);
+}
+
 void sample() {
     using namespace std::literals::string_literals;
 
@@ -147,9 +267,22 @@ void sample() {
     }
 }
 
-int main() {
-//    benchmark();
-    sample();
+// Runs the benchmark named by the argument, or the sample without arguments
+int main(int argc, char *argv[]) {
+    auto name = 1 < argc ? std::string(argv[1]) : std::string();
+
+    if (name == "perfect") {
+        benchmark();
+    } else if (name == "field_hash_set") {
+        benchmarkFieldHashSet();
+    } else if (name == "move_generator") {
+        benchmarkMoveGenerator();
+    } else if (name.empty()) {
+        sample();
+    } else {
+        std::cerr << "Unknown benchmark: " << name << std::endl;
+        return 1;
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -452,6 +452,16 @@ namespace core {
         return ((leftHigh << 1) & rightHigh) == 0L;
     }
 
+    Bitboard mirror(Bitboard x) {
+        const Bitboard column = 0x4010040100401ULL;
+
+        // Swap the left and right halves of each row, and then reverse each half of 5 cells
+        x = ((x & (0x1fULL * column)) << 5) | ((x >> 5) & (0x1fULL * column));
+        x = ((x & (0x063ULL * column)) << 3) | ((x >> 3) & (0x063ULL * column)) | (x & (0x084ULL * column));
+        x = ((x & (0x129ULL * column)) << 1) | ((x >> 1) & (0x129ULL * column)) | (x & (0x084ULL * column));
+        return x;
+    }
+
     int bitCount(uint64_t b) {
         b -= (b >> 1) & 0x5555555555555555ULL;
         b = ((b >> 2) & 0x3333333333333333ULL) + (b & 0x3333333333333333ULL);
@@ -22,6 +22,9 @@ namespace core {
 
     bool isWallBetweenLeft(int x, int maxY, Bitboard board);
 
+    // Reverses the order of the cells in each row
+    Bitboard mirror(Bitboard x);
+
     int bitCount(uint64_t b);
 }
 
@@ -17,7 +17,7 @@ namespace core {
         assert(0 <= y && y < MAX_FIELD_HEIGHT);
 
         int index = y / 6;
-        boards[index] |= getXMask(x, y - 6 * index);
+        setBoard_(index, boards[index] | getXMask(x, y - 6 * index));
     }
 
     void Field::removeBlock(int x, int y) {
@@ -25,7 +25,7 @@ namespace core {
         assert(0 <= y && y < MAX_FIELD_HEIGHT);
 
         int index = y / 6;
-        boards[index] &= ~getXMask(x, y - 6 * index);
+        setBoard_(index, boards[index] & ~getXMask(x, y - 6 * index));
     }
 
     bool Field::isEmpty(int x, int y) const {
@@ -48,14 +48,14 @@ namespace core {
         int index = lowerY / 6;
         BlocksMask mask = blocks.mask(leftX, lowerY - 6 * index);
 
-        boards[index] |= mask.low;
+        setBoard_(index, boards[index] | mask.low);
         if (index <= 2) {
-            boards[index + 1] |= mask.high;
+            setBoard_(index + 1, boards[index + 1] | mask.high);
         }
     }
 
     void Field::remove(const Blocks &blocks, int x, int y) {
-        putAtMaskIndex(blocks, x + blocks.minX, y + blocks.minY);
+        removeAtMaskIndex(blocks, x + blocks.minX, y + blocks.minY);
     }
 
     void Field::removeAtMaskIndex(const Blocks &blocks, int leftX, int lowerY) {
@@ -65,9 +65,9 @@ namespace core {
         int index = lowerY / 6;
         BlocksMask mask = blocks.mask(leftX, lowerY - 6 * index);
 
-        boards[index] &= ~mask.low;
+        setBoard_(index, boards[index] & ~mask.low);
         if (index <= 2) {
-            boards[index + 1] &= ~mask.high;
+            setBoard_(index + 1, boards[index + 1] & ~mask.high);
         }
     }
 
@@ -130,6 +130,11 @@ namespace core {
     void Field::deleteLine_(
             LineKey deleteKeyLow, LineKey deleteKeyMidLow, LineKey deleteKeyMidHigh, LineKey deleteKeyHigh
     ) {
+        // Most placements clear no rows
+        if ((deleteKeyLow | deleteKeyMidLow | deleteKeyMidHigh | deleteKeyHigh) == 0) {
+            return;
+        }
+
         // Lower half
         Bitboard newXBoardLow = deleteLine(xBoardLow, deleteKeyLow);
 
@@ -167,6 +172,8 @@ namespace core {
             xBoardMidHigh = high >> slide * 10;
             xBoardHigh = 0L;
         }
+
+        rehash_();
     }
 
     void Field::clearLine() {
@@ -189,6 +196,96 @@ namespace core {
         return deleteKeyLow | (deleteKeyMidLow << 1) | (deleteKeyMidHigh << 2) | (deleteKeyHigh << 3);
     }
 
+    void Field::deleteLineWithKey(LineKey key) {
+        LineKey deleteKeyLow = key & 0x4010040100401ULL;
+        LineKey deleteKeyMidLow = (key >> 1) & 0x4010040100401ULL;
+        LineKey deleteKeyMidHigh = (key >> 2) & 0x4010040100401ULL;
+        LineKey deleteKeyHigh = (key >> 3) & 0x4010040100401ULL;
+
+        deleteLine_(deleteKeyLow, deleteKeyMidLow, deleteKeyMidHigh, deleteKeyHigh);
+    }
+
+    void Field::mirror() {
+        for (auto &board : boards) {
+            board = core::mirror(board);
+        }
+        rehash_();
+    }
+
+    void Field::putBoard(int index, Bitboard mask) {
+        assert(0 <= index && index < 4);
+        assert((mask & ~VALID_BOARD_RANGE) == 0);
+
+        setBoard_(index, boards[index] | mask);
+    }
+
+    template<class F>
+    void Field::insertLine_(LineKey key, F insertLine) {
+        if (6 < bitCount(key)) {
+            // Insert the lowest 6 rows first, so that the rows carried to the next board fit in a board
+            LineKey lower = 0;
+            int count = 0;
+            for (int y = 0; count < 6; ++y) {
+                LineKey bit = 1ULL << ((y % 6) * 10 + y / 6);
+                if ((key & bit) != 0) {
+                    lower |= bit;
+                    count += 1;
+                }
+            }
+
+            insertLine_(lower, insertLine);
+            insertLine_(key & ~lower, insertLine);
+            return;
+        }
+
+        // Rows pushed out of the board below, to be inserted at the bottom of the next board
+        Bitboard carry = 0;
+        int carryCount = 0;
+
+        for (int index = 0; index < 4; ++index) {
+            LineKey insertKey = (key >> index) & 0x4010040100401ULL;
+            int insertCount = bitCount(insertKey);
+
+            Bitboard board = boards[index];
+            Bitboard overflow = board >> (6 - carryCount) * 10;
+            Bitboard input = ((board << carryCount * 10) | carry) & VALID_BOARD_RANGE;
+
+            Bitboard pushed = input >> (6 - insertCount) * 10;
+            setBoard_(index, insertLine(input, insertKey) & VALID_BOARD_RANGE);
+
+            carry = pushed | (overflow << insertCount * 10);
+            carryCount += insertCount;
+        }
+    }
+
+    void Field::insertBlackLineWithKey(LineKey key) {
+        insertLine_(key, [](Bitboard x, LineKey mask) {
+            return insertBlackLine(x, mask);
+        });
+    }
+
+    void Field::insertWhiteLineWithKey(LineKey key) {
+        insertLine_(key, [](Bitboard x, LineKey mask) {
+            return insertWhiteLine(x, mask);
+        });
+    }
+
+    std::array<uint32_t, FIELD_WIDTH> Field::getColumns() const {
+        // Gathers the bits at 0, 10, ..., 50 to 50, 51, ..., 55. The partial products never share a bit, so no carries
+        const Bitboard column = 0x4010040100401ULL;
+        const uint64_t gather = (1ULL << 50) | (1ULL << 41) | (1ULL << 32) | (1ULL << 23) | (1ULL << 14) | (1ULL << 5);
+
+        std::array<uint32_t, FIELD_WIDTH> columns{};
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            uint32_t bits = 0;
+            for (int index = 3; 0 <= index; --index) {
+                bits = (bits << 6) | static_cast<uint32_t>(((((boards[index] >> x) & column) * gather) >> 50) & 0x3f);
+            }
+            columns[x] = bits;
+        }
+        return columns;
+    }
+
     int Field::getBlockOnX(int x, int maxY) const {
         assert(0 <= maxY && maxY <= MAX_FIELD_HEIGHT);
 
@@ -1,24 +1,30 @@
 #ifndef CORE_FIELD_HPP
 #define CORE_FIELD_HPP
 
+#include <array>
 #include <cassert>
+#include <functional>
+#include <string>
 
 #include "types.hpp"
 #include "bits.hpp"
 #include "piece.hpp"
 
 namespace core {
-    union Field {
+    // The boards are modified only by the member functions, which keep the hash up to date
+    class Field {
     public:
-        Bitboard boards[4];
-        struct {
-            Bitboard xBoardLow;
-            Bitboard xBoardMidLow;
-            Bitboard xBoardMidHigh;
-            Bitboard xBoardHigh;
-        };
+        Field() : boards{0, 0, 0, 0}, hash_(0) {};
+
+        // The board of the rows from `6 * index`. Bit (x + 10 * (y - 6 * index)) is set if the cell (x, y) is filled
+        Bitboard getBoard(int index) const {
+            return boards[index];
+        }
 
-        Field() : xBoardLow(0), xBoardMidLow(0), xBoardMidHigh(0), xBoardHigh(0) {};
+        // The 4 boards from the low rows
+        const Bitboard *getBoards() const {
+            return boards;
+        }
 
         void setBlock(int x, int y);
 
@@ -50,19 +56,71 @@ namespace core {
 
         LineKey clearLineReturnKey();
 
+        // Removes the rows in the key, which is in the layout of `clearLineReturnKey`
+        void deleteLineWithKey(LineKey key);
+
+        // Inserts filled rows at the rows in the key. The inverse of `deleteLineWithKey` for cleared rows
+        void insertBlackLineWithKey(LineKey key);
+
+        // Inserts empty rows at the rows in the key
+        void insertWhiteLineWithKey(LineKey key);
+
+        // Flips the field left and right
+        void mirror();
+
+        // Fills the cells of the mask in the board
+        void putBoard(int index, Bitboard mask);
+
+        // Bit y of the column x is set if the cell (x, y) is filled
+        std::array<uint32_t, FIELD_WIDTH> getColumns() const;
+
         int getBlockOnX(int x, int maxY) const;
 
         bool isWallBetween(int x, int maxY) const;
 
         std::string toString(int height) const;
 
+        // The sum of the boards multiplied by the keys in `kHashKeys`, updated by the board that changes
+        uint64_t hash() const {
+            return hash_;
+        }
+
     private:
+        union {
+            Bitboard boards[4];
+            struct {
+                Bitboard xBoardLow;
+                Bitboard xBoardMidLow;
+                Bitboard xBoardMidHigh;
+                Bitboard xBoardHigh;
+            };
+        };
+
+        // The powers of the golden ratio constant, from the high board to the low board
+        static constexpr uint64_t kHashKey = 0x9e3779b97f4a7c15ULL;
+        static constexpr uint64_t kHashKeys[4] = {kHashKey * kHashKey * kHashKey, kHashKey * kHashKey, kHashKey, 1};
+
+        uint64_t hash_;
+
+        void setBoard_(int index, Bitboard board) {
+            hash_ += (board - boards[index]) * kHashKeys[index];
+            boards[index] = board;
+        }
+
+        void rehash_() {
+            hash_ = boards[0] * kHashKeys[0] + boards[1] * kHashKeys[1] + boards[2] * kHashKeys[2] + boards[3];
+        }
+
         void deleteLine_(LineKey low, LineKey midLow, LineKey midHigh, LineKey high);
+
+        template<class F>
+        void insertLine_(LineKey key, F insertLine);
     };
 
     inline bool operator==(const Field &lhs, const Field &rhs) {
-        return lhs.xBoardLow == rhs.xBoardLow && lhs.xBoardMidLow == rhs.xBoardMidLow
-               && lhs.xBoardMidHigh == rhs.xBoardMidHigh && lhs.xBoardHigh == rhs.xBoardHigh;
+        return lhs.hash() == rhs.hash()
+               && lhs.getBoard(0) == rhs.getBoard(0) && lhs.getBoard(1) == rhs.getBoard(1)
+               && lhs.getBoard(2) == rhs.getBoard(2) && lhs.getBoard(3) == rhs.getBoard(3);
     }
 
     inline bool operator!=(const Field &lhs, const Field &rhs) {
@@ -72,4 +130,14 @@ namespace core {
     Field createField(std::string marks);
 }
 
+namespace std {
+    template<>
+    struct hash<core::Field> {
+        size_t operator()(const core::Field &field) const noexcept {
+            uint64_t hash = field.hash();
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+}
+
 #endif //CORE_FIELD_HPP
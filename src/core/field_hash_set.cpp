@@ -0,0 +1,140 @@
+#include "field_hash_set.hpp"
+
+#include <thread>
+
+namespace core {
+    namespace hash_set {
+        const uint64_t kReady = 1ULL;
+
+        size_t getCapacity(size_t maxSize) {
+            size_t capacity = kSlotsPerBucket;
+            while (capacity < maxSize * 2) {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        // The top bits of the tag, so that the low bits are free for the state
+        size_t toIndex(uint64_t tag, size_t mask) {
+            return static_cast<size_t>(tag >> 32) & mask;
+        }
+    }
+
+    FieldHashSet::FieldHashSet(size_t maxSize)
+            : maxSize(maxSize), mask(hash_set::getCapacity(maxSize) - 1),
+              buckets(std::vector<hash_set::Bucket>((mask + 1) / hash_set::kSlotsPerBucket, hash_set::Bucket{})),
+              keys(std::vector<hash_set::Key>(mask + 1)), size_(0) {
+    }
+
+    bool FieldHashSet::insert(const Field &field) {
+        // The probes stop at an empty slot, which is left while the set holds at most `maxSize` fields
+        if (maxSize <= size_) {
+            return false;
+        }
+
+        uint64_t tag = hash_set::toTag(field) | hash_set::kReady;
+        for (size_t index = hash_set::toIndex(tag, mask); ; index = (index + 1) & mask) {
+            auto &slot = tagAt(index);
+            if (slot == 0) {
+                slot = tag;
+                std::copy(field.getBoards(), field.getBoards() + 4, keys[index].boards);
+                size_ += 1;
+                return true;
+            }
+
+            if (slot == tag && hash_set::equals(keys[index], field)) {
+                return false;
+            }
+        }
+    }
+
+    bool FieldHashSet::contains(const Field &field) const {
+        uint64_t tag = hash_set::toTag(field) | hash_set::kReady;
+        for (size_t index = hash_set::toIndex(tag, mask); ; index = (index + 1) & mask) {
+            auto slot = tagAt(index);
+            if (slot == 0) {
+                return false;
+            }
+
+            if (slot == tag && hash_set::equals(keys[index], field)) {
+                return true;
+            }
+        }
+    }
+
+    void FieldHashSet::clear() {
+        std::fill(buckets.begin(), buckets.end(), hash_set::Bucket{});
+        size_ = 0;
+    }
+
+    ConcurrentFieldHashSet::ConcurrentFieldHashSet(size_t maxSize)
+            : maxSize(maxSize), capacity_(hash_set::getCapacity(maxSize)), mask(capacity_ - 1),
+              buckets(new hash_set::ConcurrentBucket[capacity_ / hash_set::kSlotsPerBucket]),
+              keys(new hash_set::Key[capacity_]), size_(0) {
+        for (size_t index = 0; index < capacity_; ++index) {
+            tagAt(index).store(0, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t ConcurrentFieldHashSet::waitReady(size_t index) const {
+        auto &slot = tagAt(index);
+        uint64_t current = slot.load(std::memory_order_acquire);
+        while ((current & hash_set::kReady) == 0) {
+            std::this_thread::yield();
+            current = slot.load(std::memory_order_acquire);
+        }
+        return current;
+    }
+
+    bool ConcurrentFieldHashSet::insert(const Field &field) {
+        if (maxSize <= size_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        uint64_t tag = hash_set::toTag(field);
+        for (size_t index = hash_set::toIndex(tag, mask); ; index = (index + 1) & mask) {
+            auto &slot = tagAt(index);
+            uint64_t current = slot.load(std::memory_order_acquire);
+            if (current == 0) {
+                // Reserve the size before claiming a slot, so that at most `maxSize` slots are claimed
+                if (maxSize <= size_.fetch_add(1, std::memory_order_relaxed)) {
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                if (slot.compare_exchange_strong(current, tag, std::memory_order_acquire)) {
+                    std::copy(field.getBoards(), field.getBoards() + 4, keys[index].boards);
+                    slot.store(tag | hash_set::kReady, std::memory_order_release);
+                    return true;
+                }
+
+                // Claimed by another thread: `current` is its tag
+                size_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            if ((current & ~hash_set::kReady) == tag) {
+                waitReady(index);
+                if (hash_set::equals(keys[index], field)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    bool ConcurrentFieldHashSet::contains(const Field &field) const {
+        uint64_t tag = hash_set::toTag(field);
+        for (size_t index = hash_set::toIndex(tag, mask); ; index = (index + 1) & mask) {
+            uint64_t current = tagAt(index).load(std::memory_order_acquire);
+            if (current == 0) {
+                return false;
+            }
+
+            if ((current & ~hash_set::kReady) == tag) {
+                waitReady(index);
+                if (hash_set::equals(keys[index], field)) {
+                    return true;
+                }
+            }
+        }
+    }
+}
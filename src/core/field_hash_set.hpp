@@ -0,0 +1,135 @@
+#ifndef CORE_FIELD_HASH_SET_HPP
+#define CORE_FIELD_HASH_SET_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "field.hpp"
+
+namespace core {
+    namespace hash_set {
+        const int kSlotsPerBucket = 8;
+
+        // The tags of 8 slots in a cache line. The tag of an empty slot is 0
+        struct alignas(64) Bucket {
+            uint64_t tags[kSlotsPerBucket];
+        };
+
+        struct alignas(64) ConcurrentBucket {
+            std::atomic<uint64_t> tags[kSlotsPerBucket];
+        };
+
+        struct alignas(32) Key {
+            Bitboard boards[4];
+        };
+
+        // Mixes the linear field hash. The low bit is reserved for the state of the slot
+        inline uint64_t toTag(const Field &field) {
+            uint64_t hash = field.hash();
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+            return (hash & ~1ULL) | 2ULL;
+        }
+
+        inline bool equals(const Key &key, const Field &field) {
+#ifdef __AVX2__
+            auto lhs = _mm256_load_si256(reinterpret_cast<const __m256i *>(key.boards));
+            auto rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(field.getBoards()));
+            return _mm256_movemask_epi8(_mm256_cmpeq_epi64(lhs, rhs)) == -1;
+#else
+            return ((key.boards[0] ^ field.getBoard(0)) | (key.boards[1] ^ field.getBoard(1))
+                    | (key.boards[2] ^ field.getBoard(2)) | (key.boards[3] ^ field.getBoard(3))) == 0;
+#endif
+        }
+
+        // The number of slots: a power of 2 that keeps the load factor at most 1/2
+        size_t getCapacity(size_t maxSize);
+    }
+
+    // A set of fields in a flat table with linear probing. The capacity is fixed at construction.
+    // The tags are packed in cache lines, so that most probes touch one line of tags and one key
+    class FieldHashSet {
+    public:
+        // Holds up to `maxSize` fields
+        explicit FieldHashSet(size_t maxSize);
+
+        // Returns true if the field is added. Returns false without adding if the set already holds `maxSize` fields
+        bool insert(const Field &field);
+
+        bool contains(const Field &field) const;
+
+        size_t size() const {
+            return size_;
+        }
+
+        size_t capacity() const {
+            return keys.size();
+        }
+
+        void clear();
+
+    private:
+        const size_t maxSize;
+        const size_t mask;
+        std::vector<hash_set::Bucket> buckets;
+        std::vector<hash_set::Key> keys;
+        size_t size_;
+
+        uint64_t &tagAt(size_t index) {
+            return buckets[index / hash_set::kSlotsPerBucket].tags[index % hash_set::kSlotsPerBucket];
+        }
+
+        uint64_t tagAt(size_t index) const {
+            return buckets[index / hash_set::kSlotsPerBucket].tags[index % hash_set::kSlotsPerBucket];
+        }
+    };
+
+    // The same table as `FieldHashSet`, whose `insert` and `contains` can be called from multiple threads.
+    // A slot is claimed by CAS on its tag, and the low bit of the tag is set after the key is written
+    class ConcurrentFieldHashSet {
+    public:
+        // Holds up to `maxSize` fields
+        explicit ConcurrentFieldHashSet(size_t maxSize);
+
+        // Returns true if the field is added by this call.
+        // Returns false without adding if the set already holds `maxSize` fields
+        bool insert(const Field &field);
+
+        bool contains(const Field &field) const;
+
+        size_t size() const {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        size_t capacity() const {
+            return capacity_;
+        }
+
+    private:
+        const size_t maxSize;
+        const size_t capacity_;
+        const size_t mask;
+        std::unique_ptr<hash_set::ConcurrentBucket[]> buckets;
+        std::unique_ptr<hash_set::Key[]> keys;
+        std::atomic<size_t> size_;
+
+        std::atomic<uint64_t> &tagAt(size_t index) const {
+            return buckets[index / hash_set::kSlotsPerBucket].tags[index % hash_set::kSlotsPerBucket];
+        }
+
+        // Returns the tag after the key of the slot is written
+        uint64_t waitReady(size_t index) const;
+    };
+}
+
+#endif //CORE_FIELD_HASH_SET_HPP
@@ -1,5 +1,7 @@
 #include "moves.hpp"
 
+#include <algorithm>
+
 namespace core {
     namespace {
         uint64_t getXMask(int x, int y) {
@@ -8,6 +10,149 @@ namespace core {
 
             return 1LLU << (x + y * FIELD_WIDTH);
         }
+
+        // The row y of a column is at bit y + kFloor, and the rows under the floor are filled
+        const int kFloor = 8;
+
+        uint64_t toFloorColumn(uint32_t column) {
+            return (static_cast<uint64_t>(column) << kFloor) | ((1ULL << kFloor) - 1);
+        }
+
+        // Moves the row y + dy to the row y
+        uint64_t shiftRows(uint64_t bits, int dy) {
+            return 0 <= dy ? bits >> dy : bits << -dy;
+        }
+
+        // The rows from minY to maxY
+        uint32_t getRowRange(int minY, int maxY) {
+            if (maxY < minY) {
+                return 0;
+            }
+            return static_cast<uint32_t>(((1ULL << (maxY + 1)) - 1) & ~((1ULL << minY) - 1));
+        }
+
+        // The boards of `srs_iterative` have 6 rows of the field width, as `Field`
+        const int kBoardRows = 6;
+        const Bitboard kBoardRange = 0xfffffffffffffffULL;
+        const Bitboard kRow = 0x3ffULL;
+        const Bitboard kColumn = 0x4010040100401ULL;
+        const Bitboard kGather = 0x201008040201ULL;
+        const int kGatherShift = 45;
+
+        // The columns from minX to maxX of all rows
+        Bitboard getColumnRange(int minX, int maxX) {
+            return ((2ULL << maxX) - (1ULL << minX)) * kColumn;
+        }
+
+        // Sets the rows from minY to maxY of the first B boards
+        template<size_t B>
+        void setRowRange(srs_iterative::PositionBoards &boards, int minY, int maxY) {
+            for (size_t index = 0; index < B; ++index) {
+                int lower = std::max(minY - static_cast<int>(index) * kBoardRows, 0);
+                int upper = std::min(maxY - static_cast<int>(index) * kBoardRows, kBoardRows - 1);
+                boards[index] = lower <= upper
+                                ? ((1ULL << ((upper + 1) * FIELD_WIDTH)) - (1ULL << (lower * FIELD_WIDTH)))
+                                : 0;
+            }
+        }
+
+        // Moves the position (x, y) of the first B boards to (x + dx, y + dy), for |dy| < 6, into other boards.
+        // The positions moved across the sides of the rows are left, so mask the columns as needed
+        template<size_t B>
+        void shift(srs_iterative::PositionBoards &to, const srs_iterative::PositionBoards &from, int dx, int dy) {
+            int bits = dx + dy * FIELD_WIDTH;
+            if (0 <= bits) {
+                to[0] = (from[0] << bits) & kBoardRange;
+                for (size_t index = 1; index < B; ++index) {
+                    to[index] = ((from[index] << bits) | (from[index - 1] >> (kBoardRows * FIELD_WIDTH - bits)))
+                                & kBoardRange;
+                }
+            } else {
+                for (size_t index = 0; index < B; ++index) {
+                    to[index] = ((from[index] >> -bits) | (from[index + 1] << (kBoardRows * FIELD_WIDTH + bits)))
+                                & kBoardRange;
+                }
+            }
+        }
+
+        // The row y of the column x of the first B boards is at bit y
+        template<size_t B>
+        uint32_t getColumn(const srs_iterative::PositionBoards &boards, int x) {
+            uint32_t column = 0;
+            for (size_t index = 0; index < B; ++index) {
+                // Gathers the bits of the rows, at the multiples of the field width, to 6 bits
+                Bitboard gathered = ((boards[index] >> x) & kColumn) * kGather;
+                column |= static_cast<uint32_t>((gathered >> kGatherShift) & 0x3f) << (index * kBoardRows);
+            }
+            return column;
+        }
+
+        template<size_t B>
+        bool isEmpty(const srs_iterative::PositionBoards &boards) {
+            Bitboard any = 0;
+            for (size_t index = 0; index < B; ++index) {
+                any |= boards[index];
+            }
+            return any == 0;
+        }
+
+        bool contains(
+                const std::array<srs_iterative::PositionBoards, 4> &boards, RotateType rotateType, int x, int y
+        ) {
+            if (x < 0 || FIELD_WIDTH <= x || y < 0 || MAX_FIELD_HEIGHT <= y) {
+                return false;
+            }
+            return (boards[rotateType][y / kBoardRows] & (1ULL << (x + (y % kBoardRows) * FIELD_WIDTH))) != 0;
+        }
+
+        // Returns the index of the kick with which a rotation from a reached position ends at (x, y), or -1
+        int findKick(
+                const srs_iterative::ReachedPositions &positions, const std::array<Offset, 20> &offsets,
+                RotateType fromRotate, RotateType toRotate, int numOfKicks, int x, int y
+        ) {
+            auto head = fromRotate * 5;
+            for (int index = numOfKicks - 1; 0 <= index; --index) {
+                int fromX = x - offsets[head + index].x;
+                int fromY = y - offsets[head + index].y;
+                if (!contains(positions.reached, fromRotate, fromX, fromY)) {
+                    continue;
+                }
+
+                // The rotation takes the first kick that fits
+                bool taken = true;
+                for (int before = 0; before < index; ++before) {
+                    auto &offset = offsets[head + before];
+                    if (contains(positions.free, toRotate, fromX + offset.x, fromY + offset.y)) {
+                        taken = false;
+                        break;
+                    }
+                }
+                if (taken) {
+                    return index;
+                }
+            }
+            return -1;
+        }
+    }
+
+    void getLandableMask(
+            LandableMask &mask, const std::array<uint32_t, FIELD_WIDTH> &columns, const Blocks &blocks, int validHeight
+    ) {
+        assert(validHeight <= MAX_FIELD_HEIGHT);
+
+        uint32_t range = getRowRange(-blocks.minY, validHeight - blocks.maxY - 1);
+
+        mask.fill(0);
+        for (int x = -blocks.minX, maxX = FIELD_WIDTH - blocks.maxX; x < maxX; ++x) {
+            uint64_t blocked = 0;
+            uint64_t supported = 0;
+            for (const auto &point : blocks.points) {
+                uint64_t column = toFloorColumn(columns[x + point.x]);
+                blocked |= shiftRows(column, point.y);
+                supported |= shiftRows(column, point.y - 1);
+            }
+            mask[x] = static_cast<uint32_t>((~blocked & supported) >> kFloor) & range;
+        }
     }
 
     void Cache::visit(int x, int y, RotateType rotateType) {
@@ -124,8 +269,98 @@ namespace core {
     }
 
     namespace srs {
+        namespace {
+            // Returns true if the rotation with the first kick only renames the same cells for all directions
+            bool isRotationInPlace(const Piece &piece) {
+                auto isSameCells = [](const Blocks &from, const Blocks &to, const Offset &offset) {
+                    for (const auto &point : from.points) {
+                        auto found = std::any_of(to.points.begin(), to.points.end(), [&](const Point &toPoint) {
+                            return toPoint.x + offset.x == point.x && toPoint.y + offset.y == point.y;
+                        });
+                        if (!found) {
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    auto &fromBlocks = piece.blocks[rotate];
+                    auto &rightBlocks = piece.blocks[(rotate + 1) % 4];
+                    auto &leftBlocks = piece.blocks[(rotate + 3) % 4];
+                    if (!isSameCells(fromBlocks, rightBlocks, piece.rightOffsets[rotate * 5])
+                        || !isSameCells(fromBlocks, leftBlocks, piece.leftOffsets[rotate * 5])) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // Same as `srs::right` and `srs::left` with the number of kicks fixed
+            template<size_t N>
+            int getKickIndex(
+                    const Field &field, const std::array<Offset, 20> &offsets, RotateType fromRotate,
+                    const Blocks &toBlocks, int fromX, int fromY
+            ) {
+                int fromLeftX = fromX + toBlocks.minX;
+                int fromLowerY = fromY + toBlocks.minY;
+
+                int head = fromRotate * 5;
+                int width = FIELD_WIDTH - toBlocks.width;
+                for (size_t index = 0; index < N; ++index) {
+                    auto &offset = offsets[head + index];
+                    int toX = fromLeftX + offset.x;
+                    int toY = fromLowerY + offset.y;
+                    if (0 <= toX && toX <= width && 0 <= toY && field.canPutAtMaskIndex(toBlocks, toX, toY)) {
+                        return head + static_cast<int>(index);
+                    }
+                }
+
+                return -1;
+            }
+        }
+
+        template<size_t N>
+        MoveGenerator::Search MoveGenerator::selectSearch(bool rotates) {
+            return rotates ? &MoveGenerator::search_<N, true> : &MoveGenerator::search_<N, false>;
+        }
+
+        MoveGenerator::MoveGenerator(const Factory &factory)
+                : factory(factory), cache(Cache()), appearY(-1), searches(std::array<Search, 7>{}) {
+            for (int piece = 0; piece < 7; ++piece) {
+                auto &target = factory.get(static_cast<PieceType>(piece));
+                bool rotates = !isRotationInPlace(target);
+                switch (target.offsetsSize) {
+                    case 1:
+                        searches[piece] = selectSearch<1>(rotates);
+                        break;
+                    case 2:
+                        searches[piece] = selectSearch<2>(rotates);
+                        break;
+                    case 3:
+                        searches[piece] = selectSearch<3>(rotates);
+                        break;
+                    case 4:
+                        searches[piece] = selectSearch<4>(rotates);
+                        break;
+                    case 5:
+                        searches[piece] = selectSearch<5>(rotates);
+                        break;
+                    default:
+                        assert(false);
+                }
+            }
+        }
+
         void MoveGenerator::search(
                 std::vector<Move> &moves, const Field &field, const PieceType pieceType, int validHeight
+        ) {
+            (this->*searches[pieceType])(moves, field, pieceType, validHeight);
+        }
+
+        template<size_t N, bool Rotates>
+        void MoveGenerator::search_(
+                std::vector<Move> &moves, const Field &field, const PieceType pieceType, int validHeight
         ) {
             appearY = validHeight;
 
@@ -134,33 +369,64 @@ namespace core {
             auto &piece = factory.get(pieceType);
             auto target = TargetObject{field, piece};
 
+            auto columns = field.getColumns();
+            auto landable = LandableMask{};
+
+            // Without overhangs, the blocks of each column are contiguous from the bottom.
+            // Then every landing is reachable by harddrop, and the search is skipped
+            bool hasOverhangs = false;
+            for (int x = 0; x < FIELD_WIDTH; ++x) {
+                if ((columns[x] & (columns[x] + 1)) != 0) {
+                    hasOverhangs = true;
+                    break;
+                }
+            }
+
             for (int rotate = 0; rotate < 4; ++rotate) {
                 auto rotateType = static_cast<RotateType >(rotate);
 
                 auto &blocks = factory.get(pieceType, rotateType);
+                getLandableMask(landable, columns, blocks, validHeight);
+
                 for (int x = -blocks.minX, maxX = FIELD_WIDTH - blocks.maxX; x < maxX; ++x) {
-                    for (int y = validHeight - blocks.maxY - 1; -blocks.minY <= y; --y) {
-                        if (field.canPut(blocks, x, y) && field.isOnGround(blocks, x, y)) {
-                            auto result = check(target, blocks, x, y, From::None, true);
-                            if (result != MoveResults::No) {
-                                cache.found(x, y, rotateType);
-
-                                auto &transform = piece.transforms[rotateType];
-                                RotateType newRotate = transform.toRotate;
-                                int newX = x + transform.offset.x;
-                                int newY = y + transform.offset.y;
-                                if (!cache.isPushed(newX, newY, newRotate)) {
-                                    cache.push(newX, newY, newRotate);
-                                    moves.push_back(Move{newRotate, newX, newY, result == MoveResults::Harddrop});
-                                }
+                    // From the top, in the same order as scanning y downward
+                    uint32_t bits = landable[x];
+                    while (bits != 0) {
+                        int y = 31 - __builtin_clz(bits);
+                        bits &= ~(1U << y);
+
+                        if (!hasOverhangs) {
+                            auto &transform = piece.transforms[rotateType];
+                            RotateType newRotate = transform.toRotate;
+                            int newX = x + transform.offset.x;
+                            int newY = y + transform.offset.y;
+                            if (!cache.isPushed(newX, newY, newRotate)) {
+                                cache.push(newX, newY, newRotate);
+                                moves.push_back(Move{newRotate, newX, newY, true});
                             }
-                            cache.resetTrail();
+                            continue;
                         }
+
+                        auto result = check<N, Rotates>(target, blocks, x, y, From::None, true);
+                        if (result != MoveResults::No) {
+                            cache.found(x, y, rotateType);
+
+                            auto &transform = piece.transforms[rotateType];
+                            RotateType newRotate = transform.toRotate;
+                            int newX = x + transform.offset.x;
+                            int newY = y + transform.offset.y;
+                            if (!cache.isPushed(newX, newY, newRotate)) {
+                                cache.push(newX, newY, newRotate);
+                                moves.push_back(Move{newRotate, newX, newY, result == MoveResults::Harddrop});
+                            }
+                        }
+                        cache.resetTrail();
                     }
                 }
             }
         }
 
+        template<size_t N>
         MoveResults MoveGenerator::checkLeftRotation(
                 const TargetObject &targetObject, const Blocks &toBlocks, int toX, int toY
         ) {
@@ -175,24 +441,24 @@ namespace core {
             int toLeftX = toX + fromBlocks.minX;
             int toLowerY = toY + fromBlocks.minY;
 
-            auto head = fromRotate * 5;
+            int head = fromRotate * 5;
             int width = FIELD_WIDTH - fromBlocks.width;
-            for (int index = head; index < head + piece.offsetsSize; ++index) {
-                auto &offset = piece.leftOffsets[index];
+            for (size_t index = 0; index < N; ++index) {
+                auto &offset = piece.leftOffsets[head + index];
                 int fromLeftX = toLeftX - offset.x;
                 int fromLowerY = toLowerY - offset.y;
                 if (0 <= fromLeftX && fromLeftX <= width && 0 <= fromLowerY &&
                     field.canPutAtMaskIndex(fromBlocks, fromLeftX, fromLowerY)) {
                     int fromX = toX - offset.x;
                     int fromY = toY - offset.y;
-                    int srsResult = srs::left(field, piece, fromRotate, toBlocks, fromX, fromY);
+                    int srsResult = getKickIndex<N>(field, piece.leftOffsets, fromRotate, toBlocks, fromX, fromY);
                     if (srsResult == -1) {
                         continue;
                     }
 
                     auto &kicks = piece.leftOffsets[srsResult];
                     if (offset.x == kicks.x && offset.y == kicks.y) {
-                        auto result = check(targetObject, fromBlocks, fromX, fromY, From::None, false);
+                        auto result = check<N, true>(targetObject, fromBlocks, fromX, fromY, From::None, false);
                         if (result != MoveResults::No) {
                             return result;
                         }
@@ -203,6 +469,7 @@ namespace core {
             return MoveResults::No;
         }
 
+        template<size_t N>
         MoveResults MoveGenerator::checkRightRotation(
                 const TargetObject &targetObject, const Blocks &toBlocks, int toX, int toY
         ) {
@@ -217,24 +484,24 @@ namespace core {
             int toLeftX = toX + fromBlocks.minX;
             int toLowerY = toY + fromBlocks.minY;
 
-            auto head = fromRotate * 5;
+            int head = fromRotate * 5;
             int width = FIELD_WIDTH - fromBlocks.width;
-            for (int index = head; index < head + piece.offsetsSize; ++index) {
-                auto &offset = piece.rightOffsets[index];
+            for (size_t index = 0; index < N; ++index) {
+                auto &offset = piece.rightOffsets[head + index];
                 int fromLeftX = toLeftX - offset.x;
                 int fromLowerY = toLowerY - offset.y;
                 if (0 <= fromLeftX && fromLeftX <= width && 0 <= fromLowerY &&
                     field.canPutAtMaskIndex(fromBlocks, fromLeftX, fromLowerY)) {
                     int fromX = toX - offset.x;
                     int fromY = toY - offset.y;
-                    int srsResult = srs::right(field, piece, fromRotate, toBlocks, fromX, fromY);
+                    int srsResult = getKickIndex<N>(field, piece.rightOffsets, fromRotate, toBlocks, fromX, fromY);
                     if (srsResult == -1) {
                         continue;
                     }
 
                     auto &kicks = piece.rightOffsets[srsResult];
                     if (offset.x == kicks.x && offset.y == kicks.y) {
-                        auto result = check(targetObject, fromBlocks, fromX, fromY, From::None, false);
+                        auto result = check<N, true>(targetObject, fromBlocks, fromX, fromY, From::None, false);
                         if (result != MoveResults::No) {
                             return result;
                         }
@@ -245,6 +512,7 @@ namespace core {
             return MoveResults::No;
         }
 
+        template<size_t N, bool Rotates>
         MoveResults MoveGenerator::check(
                 const TargetObject &targetObject, const Blocks &blocks, int x, int y, From from, bool isFirstCall
         ) {
@@ -273,7 +541,7 @@ namespace core {
             // Move up
             int upY = y + 1;
             if (upY < appearY && field.canPut(blocks, x, upY)) {
-                auto result = check(targetObject, blocks, x, upY, From::None, false);
+                auto result = check<N, Rotates>(targetObject, blocks, x, upY, From::None, false);
                 if (result != MoveResults::No) {
                     return result;
                 }
@@ -282,7 +550,7 @@ namespace core {
             // Move left
             int leftX = x - 1;
             if (from != From::Left && -blocks.minX <= leftX && field.canPut(blocks, leftX, y)) {
-                auto result = check(targetObject, blocks, leftX, y, From::Right, false);
+                auto result = check<N, Rotates>(targetObject, blocks, leftX, y, From::Right, false);
                 if (result != MoveResults::No) {
                     return result;
                 }
@@ -291,26 +559,28 @@ namespace core {
             // Move right
             int rightX = x + 1;
             if (from != From::Right && rightX < FIELD_WIDTH - blocks.maxX && field.canPut(blocks, rightX, y)) {
-                auto result = check(targetObject, blocks, rightX, y, From::Left, false);
+                auto result = check<N, Rotates>(targetObject, blocks, rightX, y, From::Left, false);
                 if (result != MoveResults::No) {
                     return result;
                 }
             }
 
-            // Move the place where there is a possibility of rotating right
-            {
-                auto result = checkRightRotation(targetObject, blocks, x, y);
-                if (result != MoveResults::No) {
-                    return result;
+            if constexpr (Rotates) {
+                // Move the place where there is a possibility of rotating right
+                {
+                    auto result = checkRightRotation<N>(targetObject, blocks, x, y);
+                    if (result != MoveResults::No) {
+                        return result;
+                    }
                 }
-            }
 
-            // Move the place where there is a possibility of rotating left
-            {
+                // Move the place where there is a possibility of rotating left
+                {
 
-                auto result = checkLeftRotation(targetObject, blocks, x, y);
-                if (result != MoveResults::No) {
-                    return result;
+                    auto result = checkLeftRotation<N>(targetObject, blocks, x, y);
+                    if (result != MoveResults::No) {
+                        return result;
+                    }
                 }
             }
 
@@ -318,6 +588,460 @@ namespace core {
         }
     }
 
+    namespace srs_iterative {
+        MoveGenerator::MoveGenerator(const Factory &factory) : MoveGenerator(factory, false) {
+        }
+
+        MoveGenerator::MoveGenerator(const Factory &factory, bool classifies)
+                : factory(factory), classifies(classifies), maxKickDowns(std::array<int, 7>{}),
+                  cells(std::array<std::vector<Cell>, 7>{}) {
+            for (int piece = 0; piece < 7; ++piece) {
+                auto &target = factory.get(static_cast<PieceType>(piece));
+
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    for (const auto &point : target.blocks[rotate].points) {
+                        auto it = std::find_if(cells[piece].begin(), cells[piece].end(), [&](const Cell &cell) {
+                            return cell.point.x == point.x && cell.point.y == point.y;
+                        });
+                        if (it == cells[piece].end()) {
+                            cells[piece].push_back(Cell{point, 1 << rotate});
+                        } else {
+                            it->rotateBit |= 1 << rotate;
+                        }
+                    }
+                }
+
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    for (int index = 0; index < static_cast<int>(target.offsetsSize); ++index) {
+                        auto down = std::max(-target.rightOffsets[rotate * 5 + index].y,
+                                             -target.leftOffsets[rotate * 5 + index].y);
+                        maxKickDowns[piece] = std::max(maxKickDowns[piece], down);
+                    }
+                }
+                assert(maxKickDowns[piece] < kBoardRows);
+            }
+        }
+
+        void MoveGenerator::search(
+                std::vector<Move> &moves, const Field &field, const PieceType pieceType, int validHeight
+        ) {
+            load(field);
+            generate(moves, pieceType, validHeight);
+        }
+
+        void MoveGenerator::search(
+                std::array<std::vector<Move>, 7> &moves, const Field &field, int pieceBit, int validHeight
+        ) {
+            assert(0 <= pieceBit && pieceBit < (1 << 7));
+
+            load(field);
+            for (int piece = 0; piece < 7; ++piece) {
+                if ((pieceBit & (1 << piece)) != 0) {
+                    moves[piece].clear();
+                    generate(moves[piece], static_cast<PieceType>(piece), validHeight);
+                }
+            }
+        }
+
+        void MoveGenerator::load(const Field &field) {
+            boards.fill(0);
+            skies.fill(kBoardRange);
+
+            // Spread the blocks down from the top, including the blocks of the boards above
+            Bitboard covered = 0;
+            for (int index = 3; 0 <= index; --index) {
+                boards[index] = field.getBoard(index);
+
+                covered = ((covered & kRow) * kColumn) | boards[index];
+                covered |= covered >> FIELD_WIDTH;
+                covered |= covered >> (2 * FIELD_WIDTH);
+                covered |= covered >> (4 * FIELD_WIDTH);
+                skies[index] = ~covered & kBoardRange;
+            }
+        }
+
+        void MoveGenerator::generate(std::vector<Move> &moves, PieceType pieceType, int validHeight) {
+            assert(0 < validHeight && validHeight <= MAX_FIELD_HEIGHT);
+
+            auto &piece = factory.get(pieceType);
+
+            positions.pieceType = pieceType;
+            positions.validHeight = validHeight;
+
+            // The positions above the appearance matter only if a kick can move the piece below it
+            int numOfRows = std::min(validHeight + maxKickDowns[pieceType], MAX_FIELD_HEIGHT);
+            switch ((numOfRows + kBoardRows - 1) / kBoardRows) {
+                case 1:
+                    generate_<1>(moves, piece, validHeight, numOfRows);
+                    return;
+                case 2:
+                    generate_<2>(moves, piece, validHeight, numOfRows);
+                    return;
+                case 3:
+                    generate_<3>(moves, piece, validHeight, numOfRows);
+                    return;
+                case 4:
+                    generate_<4>(moves, piece, validHeight, numOfRows);
+                    return;
+                default:
+                    assert(false);
+            }
+        }
+
+        template<size_t B>
+        void MoveGenerator::generate_(std::vector<Move> &moves, const Piece &piece, int validHeight, int numOfRows) {
+            int appearY = validHeight;
+
+            // Start from the positions reachable by harddrop, and the positions above the appearance
+            auto below = PositionBoards{};
+            auto above = PositionBoards{};
+            setRowRange<B>(below, 0, appearY - 1);
+            setRowRange<B>(above, appearY, numOfRows - 1);
+
+            for (int rotate = 0; rotate < 4; ++rotate) {
+                auto &blocks = piece.blocks[rotate];
+
+                auto &free = positions.free[rotate];
+                setRowRange<B>(free, -blocks.minY, std::min(MAX_FIELD_HEIGHT - blocks.maxY, numOfRows) - 1);
+
+                Bitboard columns = getColumnRange(-blocks.minX, FIELD_WIDTH - blocks.maxX - 1);
+                for (size_t index = 0; index < B; ++index) {
+                    free[index] &= columns;
+                }
+                harddropBoards[rotate] = free;
+            }
+
+            // A position is blocked if a cell of the blocks is filled, and is harddrop if all cells are in the sky.
+            // The rotations that have the same cell share the shifted boards
+            auto blocked = PositionBoards{};
+            auto sky = PositionBoards{};
+            for (const auto &cell : cells[piece.pieceType]) {
+                shift<B>(blocked, boards, -cell.point.x, -cell.point.y);
+                shift<B>(sky, skies, -cell.point.x, -cell.point.y);
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    if ((cell.rotateBit & (1 << rotate)) == 0) {
+                        continue;
+                    }
+                    auto &free = positions.free[rotate];
+                    auto &harddrop = harddropBoards[rotate];
+                    for (size_t index = 0; index < B; ++index) {
+                        free[index] &= ~blocked[index];
+                        harddrop[index] &= sky[index];
+                    }
+                }
+            }
+
+            for (int rotate = 0; rotate < 4; ++rotate) {
+                auto &free = positions.free[rotate];
+                auto &harddrop = harddropBoards[rotate];
+                auto &reached = positions.reached[rotate];
+                for (size_t index = 0; index < B; ++index) {
+                    reached[index] = (harddrop[index] & below[index]) | (free[index] & above[index]);
+                }
+                for (size_t index = B; index < reached.size(); ++index) {
+                    free[index] = 0;
+                    harddrop[index] = 0;
+                    reached[index] = 0;
+                }
+
+                rotatedBoards[rotate].fill(0);
+                pushedBoards[rotate].fill(0);
+            }
+
+            // The rotations whose reached positions changed since they were filled
+            int changed = 0b1111;
+            while (changed != 0) {
+                int filled = changed;
+                changed = 0;
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    if ((filled & (1 << rotate)) != 0) {
+                        fill<B>(static_cast<RotateType>(rotate), below);
+                    }
+                }
+
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    if ((filled & (1 << rotate)) == 0) {
+                        continue;
+                    }
+
+                    auto pending = PositionBoards{};
+                    auto &reached = positions.reached[rotate];
+                    auto &rotated = rotatedBoards[rotate];
+                    for (size_t index = 0; index < B; ++index) {
+                        pending[index] = reached[index] & ~rotated[index];
+                        rotated[index] |= pending[index];
+                    }
+                    if (isEmpty<B>(pending)) {
+                        continue;
+                    }
+
+                    auto fromRotate = static_cast<RotateType>(rotate);
+                    int right = (rotate + 1) % 4;
+                    int left = (rotate + 3) % 4;
+                    if (tryRotate<B>(piece, fromRotate, static_cast<RotateType>(right), piece.rightOffsets, pending)) {
+                        changed |= 1 << right;
+                    }
+                    if (tryRotate<B>(piece, fromRotate, static_cast<RotateType>(left), piece.leftOffsets, pending)) {
+                        changed |= 1 << left;
+                    }
+                }
+            }
+
+            auto landable = PositionBoards{};
+            auto landableRows = PositionBoards{};
+            auto fresh = PositionBoards{};
+            for (int rotate = 0; rotate < 4; ++rotate) {
+                auto rotateType = static_cast<RotateType>(rotate);
+
+                // On the ground if the blocks cannot be put one row below
+                auto &blocks = piece.blocks[rotate];
+                auto &free = positions.free[rotate];
+                auto &reached = positions.reached[rotate];
+                setRowRange<B>(landableRows, -blocks.minY, validHeight - blocks.maxY - 1);
+                shift<B>(landable, free, 0, 1);
+                Bitboard any = 0;
+                for (size_t index = 0; index < B; ++index) {
+                    landable[index] = free[index] & ~landable[index] & landableRows[index] & reached[index];
+                    any |= landable[index];
+                }
+
+                if (any == 0) {
+                    continue;
+                }
+
+                // Move to the rotation that generates the moves of the same shape, and skip the moves generated
+                auto &transform = piece.transforms[rotateType];
+                RotateType newRotate = transform.toRotate;
+                auto &pushed = pushedBoards[newRotate];
+                auto &harddrop = harddropBoards[rotate];
+                int dx = transform.offset.x;
+                int dy = transform.offset.y;
+
+                shift<B>(fresh, landable, dx, dy);
+                any = 0;
+                for (size_t index = 0; index < B; ++index) {
+                    fresh[index] &= ~pushed[index];
+                    pushed[index] |= fresh[index];
+                    any |= fresh[index];
+                }
+
+                // The columns that have a new move
+                any |= any >> (3 * FIELD_WIDTH);
+                any |= any >> FIELD_WIDTH;
+                auto columns = static_cast<uint32_t>((any | (any >> (2 * FIELD_WIDTH))) & kRow);
+
+                while (columns != 0) {
+                    int newX = __builtin_ctz(columns);
+                    columns &= columns - 1;
+
+                    // From the top, in the same order as `srs::MoveGenerator`
+                    uint32_t column = getColumn<B>(fresh, newX);
+                    while (column != 0) {
+                        int newY = 31 - __builtin_clz(column);
+                        column &= ~(1U << newY);
+
+                        int x = newX - dx;
+                        int y = newY - dy;
+                        auto bit = 1ULL << (x + (y % kBoardRows) * FIELD_WIDTH);
+                        bool isHarddrop = (harddrop[y / kBoardRows] & bit) != 0;
+                        auto lastAction = classifies
+                                          ? getLastAction(piece, newRotate, newX, newY)
+                                          : LastActions::Unclassified;
+                        moves.push_back(Move{newRotate, newX, newY, isHarddrop, lastAction});
+                    }
+                }
+            }
+        }
+
+        LastActions MoveGenerator::getLastAction(const Piece &piece, RotateType rotateType, int x, int y) const {
+            auto action = LastActions::MoveLast;
+
+            // The landing is the same for the rotations of the same shape
+            auto bit = piece.sameShapeRotates[rotateType];
+            assert(bit != 0);
+
+            do {
+                auto next = bit & (bit - 1);
+                RotateType nextRotateType = rotateBitToVal[bit & ~next];
+
+                auto &nextTransform = piece.transforms[nextRotateType];
+                auto nextX = x - nextTransform.offset.x;
+                auto nextY = y - nextTransform.offset.y;
+
+                int kickIndex = positions.getKickIndex(piece, nextRotateType, nextX, nextY);
+                if (kickIndex == 4) {
+                    return LastActions::RotateLastWithLastKick;
+                }
+
+                if (0 <= kickIndex) {
+                    action = LastActions::RotateLast;
+                }
+
+                bit = next;
+            } while (bit != 0);
+
+            return action;
+        }
+
+        template<size_t B>
+        void MoveGenerator::fill(RotateType rotateType, const PositionBoards &below) {
+            auto &reached = positions.reached[rotateType];
+            auto &free = positions.free[rotateType];
+
+            // Nothing to spread, such as in the field without overhangs
+            Bitboard unreached = 0;
+            for (size_t index = 0; index < B; ++index) {
+                unreached |= free[index] & ~reached[index];
+            }
+            if (unreached == 0) {
+                return;
+            }
+
+            const Bitboard notLeftmost = kBoardRange & ~kColumn;
+            const Bitboard notRightmost = kBoardRange & ~(kColumn << (FIELD_WIDTH - 1));
+
+            while (true) {
+                // Move right and left through the free positions of the rows by doubling the distance
+                for (size_t index = 0; index < B; ++index) {
+                    Bitboard current = reached[index];
+
+                    Bitboard through = free[index] & notLeftmost;
+                    current |= through & (current << 1);
+                    through &= through << 1;
+                    current |= through & (current << 2);
+                    through &= through << 2;
+                    current |= through & (current << 4);
+                    through &= through << 4;
+                    current |= through & (current << 8);
+
+                    through = free[index] & notRightmost;
+                    current |= through & (current >> 1);
+                    through &= through >> 1;
+                    current |= through & (current >> 2);
+                    through &= through >> 2;
+                    current |= through & (current >> 4);
+                    through &= through >> 4;
+                    current |= through & (current >> 8);
+
+                    reached[index] = current;
+                }
+
+                // Move down below the appearance, from the top board to carry the lowest row to the next board.
+                // The rows are closed under the moves to the sides until a position is reached by moving down
+                Bitboard grown = 0;
+                Bitboard carry = 0;
+                for (int index = B - 1; 0 <= index; --index) {
+                    Bitboard down = (reached[index] & below[index]) | (carry & free[index]);
+                    Bitboard through = free[index];
+                    down |= through & (down >> FIELD_WIDTH);
+                    through &= through >> FIELD_WIDTH;
+                    down |= through & (down >> (2 * FIELD_WIDTH));
+                    through &= through >> (2 * FIELD_WIDTH);
+                    down |= through & (down >> (4 * FIELD_WIDTH));
+
+                    carry = (down & kRow) << ((kBoardRows - 1) * FIELD_WIDTH);
+                    grown |= down & ~reached[index];
+                    reached[index] |= down;
+                }
+
+                if (grown == 0) {
+                    return;
+                }
+            }
+        }
+
+        template<size_t B>
+        bool MoveGenerator::tryRotate(
+                const Piece &piece, RotateType fromRotate, RotateType toRotate,
+                const std::array<Offset, 20> &offsets, const PositionBoards &pending
+        ) {
+            auto &free = positions.free[toRotate];
+            auto &reached = positions.reached[toRotate];
+
+            // Only the new positions matter, since the ends of the rotations are found from the positions later
+            auto targets = PositionBoards{};
+            for (size_t board = 0; board < B; ++board) {
+                targets[board] = free[board] & ~reached[board];
+            }
+            if (isEmpty<B>(targets)) {
+                return false;
+            }
+
+            auto head = fromRotate * 5;
+            auto numOfKicks = static_cast<int>(piece.offsetsSize);
+
+            // The positions from which each kick stays in the field
+            std::array<Bitboard, 5> columns{};
+            for (int index = 0; index < numOfKicks; ++index) {
+                auto &offset = offsets[head + index];
+                columns[index] = 0 <= offset.x
+                                 ? getColumnRange(0, FIELD_WIDTH - 1 - offset.x)
+                                 : getColumnRange(-offset.x, FIELD_WIDTH - 1);
+            }
+
+            // The positions from which a kick may end at a new position
+            auto left = PositionBoards{};
+            auto fits = PositionBoards{};
+            for (int index = 0; index < numOfKicks; ++index) {
+                auto &offset = offsets[head + index];
+                shift<B>(fits, targets, -offset.x, -offset.y);
+                for (size_t board = 0; board < B; ++board) {
+                    left[board] |= fits[board] & columns[index];
+                }
+            }
+            for (size_t board = 0; board < B; ++board) {
+                left[board] &= pending[board];
+            }
+            if (isEmpty<B>(left)) {
+                return false;
+            }
+
+            // The positions in `left` have not fit any kick yet. The first kick that fits is taken
+            auto ends = PositionBoards{};
+
+            bool updated = false;
+            for (int index = 0; index < numOfKicks; ++index) {
+                auto &offset = offsets[head + index];
+
+                shift<B>(fits, free, -offset.x, -offset.y);
+                Bitboard any = 0;
+                for (size_t board = 0; board < B; ++board) {
+                    fits[board] &= left[board] & columns[index];
+                    left[board] &= ~fits[board];
+                    any |= fits[board];
+                }
+                if (any == 0) {
+                    continue;
+                }
+
+                shift<B>(ends, fits, offset.x, offset.y);
+                for (size_t board = 0; board < B; ++board) {
+                    if ((ends[board] & ~reached[board]) != 0) {
+                        reached[board] |= ends[board];
+                        updated = true;
+                    }
+                }
+
+                if (isEmpty<B>(left)) {
+                    break;
+                }
+            }
+
+            return updated;
+        }
+
+        int ReachedPositions::getKickIndex(const Piece &piece, RotateType rotateType, int x, int y) const {
+            auto numOfKicks = static_cast<int>(piece.offsetsSize);
+            // Directions before right and left rotations
+            auto beforeRight = static_cast<RotateType>((rotateType + 3) % 4);
+            auto beforeLeft = static_cast<RotateType>((rotateType + 1) % 4);
+            return std::max(
+                    findKick(*this, piece.rightOffsets, beforeRight, rotateType, numOfKicks, x, y),
+                    findKick(*this, piece.leftOffsets, beforeLeft, rotateType, numOfKicks, x, y)
+            );
+        }
+    }
+
     namespace srs_rotate_end {
         bool Reachable::checks(
                 const Field &field, PieceType pieceType, RotateType rotateType, int x, int y, int validHeight
@@ -363,6 +1087,41 @@ namespace core {
             return false;
         }
 
+        bool Reachable::checks(
+                const srs_iterative::ReachedPositions &positions, PieceType pieceType, RotateType rotateType,
+                int x, int y
+        ) const {
+            assert(positions.pieceType == pieceType);
+
+            auto &piece = factory.get(pieceType);
+
+            auto &transform = piece.transforms[rotateType];
+            auto currentRotateType = transform.toRotate;
+            auto currentX = x + transform.offset.x;
+            auto currentY = y + transform.offset.y;
+
+            auto bit = piece.sameShapeRotates[currentRotateType];
+            assert(bit != 0);
+
+            do {
+                auto next = bit & (bit - 1);
+                RotateType nextRotateType = rotateBitToVal[bit & ~next];
+
+                auto &nextTransform = piece.transforms[nextRotateType];
+
+                auto nextX = currentX - nextTransform.offset.x;
+                auto nextY = currentY - nextTransform.offset.y;
+
+                if (0 <= positions.getKickIndex(piece, nextRotateType, nextX, nextY)) {
+                    return true;
+                }
+
+                bit = next;
+            } while (bit != 0);
+
+            return false;
+        }
+
         MoveResults Reachable::checkLeftRotation(
                 const TargetObject &targetObject, const Blocks &toBlocks, int toX, int toY
         ) {
@@ -8,11 +8,21 @@
 #include "srs.hpp"
 
 namespace core {
+    // The last action that can bring the piece to the landing. Only the generators that classify moves set it
+    enum LastActions {
+        Unclassified = 0,
+        MoveLast = 1,
+        RotateLast = 2,
+        // A rotation with the last kick of the table, which upgrades T-Spin Mini
+        RotateLastWithLastKick = 3,
+    };
+
     struct Move {
         RotateType rotateType;
         int x;
         int y;
         bool harddrop;
+        LastActions lastAction = LastActions::Unclassified;
     };
 
     enum MoveResults {
@@ -27,13 +37,21 @@ namespace core {
     };
 
     inline bool operator==(const Move &lhs, const Move &rhs) {
-        return lhs.rotateType == rhs.rotateType && lhs.x == rhs.x && lhs.y == rhs.y && lhs.harddrop == rhs.harddrop;
+        return lhs.rotateType == rhs.rotateType && lhs.x == rhs.x && lhs.y == rhs.y && lhs.harddrop == rhs.harddrop
+               && lhs.lastAction == rhs.lastAction;
     }
 
     inline bool operator!=(const Move &lhs, const Move &rhs) {
         return !(lhs == rhs);
     }
 
+    // Bit y of the x-th mask is set if the blocks can be put at (x, y) on the ground, and are below `validHeight`
+    using LandableMask = std::array<uint32_t, FIELD_WIDTH>;
+
+    void getLandableMask(
+            LandableMask &mask, const std::array<uint32_t, FIELD_WIDTH> &columns, const Blocks &blocks, int validHeight
+    );
+
     class Cache {
     public:
         void visit(int x, int y, RotateType rotateType);
@@ -80,27 +98,134 @@ namespace core {
 
         class MoveGenerator {
         public:
-            MoveGenerator(const Factory &factory) : factory(factory), cache(Cache()), appearY(-1) {
-            }
+            MoveGenerator(const Factory &factory);
 
             void search(std::vector<Move> &moves, const Field &field, const PieceType pieceType, int validHeight);
 
         private:
+            using Search = void (MoveGenerator::*)(std::vector<Move> &, const Field &, PieceType, int);
+
             const Factory &factory;
 
             Cache cache;
             int appearY;
 
+            // The search of each piece, specialized for the number of its kicks.
+            // Rotations are skipped for the pieces whose rotations only rename the same cells, like O
+            std::array<Search, 7> searches;
+
+            template<size_t N>
+            static Search selectSearch(bool rotates);
+
+            template<size_t N, bool Rotates>
+            void search_(std::vector<Move> &moves, const Field &field, PieceType pieceType, int validHeight);
+
+            template<size_t N>
             MoveResults checkLeftRotation(const TargetObject &targetObject, const Blocks &toBlocks, int toX, int toY);
 
+            template<size_t N>
             MoveResults checkRightRotation(const TargetObject &targetObject, const Blocks &toBlocks, int toX, int toY);
 
+            template<size_t N, bool Rotates>
             MoveResults check(
                     const TargetObject &targetObject, const Blocks &blocks, int x, int y, From from, bool isFirstCall
             );
         };
     }
 
+    namespace srs_iterative {
+        // The positions of a piece in the layout of `Field`: bit (x + 10 * (y - 6 * index)) of the board `index`
+        // is the position (x, y). The boards above the field stay empty, so that a shift can read the rows above
+        using PositionBoards = std::array<Bitboard, 6>;
+
+        // The positions of a piece that a search reached
+        struct ReachedPositions {
+            PieceType pieceType;
+            int validHeight;
+            std::array<PositionBoards, 4> reached;
+
+            // The positions where the blocks are in the field and do not overlap the blocks of the field
+            std::array<PositionBoards, 4> free;
+
+            // Returns the index of the kick with which a rotation from a reached position ends at the position,
+            // or -1 if no rotation ends at it. If the rotations of both directions end at it, the larger one
+            int getKickIndex(const Piece &piece, RotateType rotateType, int x, int y) const;
+        };
+
+        // Generates the same moves as `srs::MoveGenerator` in the same order.
+        // Instead of searching back from each landing position, the positions that are reachable from the top are
+        // filled forward once per search. Each rotation keeps the positions as boards of rows,
+        // so a move or a kick is a shift of all positions at once
+        class MoveGenerator {
+        public:
+            MoveGenerator(const Factory &factory);
+
+            // If `classifies` is true, `Move::lastAction` of the moves is set
+            MoveGenerator(const Factory &factory, bool classifies);
+
+            void search(std::vector<Move> &moves, const Field &field, PieceType pieceType, int validHeight);
+
+            // Generates the moves of each piece in the bit into `moves[piece]`.
+            // The boards of the field are built once for all pieces
+            void search(std::array<std::vector<Move>, 7> &moves, const Field &field, int pieceBit, int validHeight);
+
+            // The positions of the last generated piece, valid until the next search
+            const ReachedPositions &getReachedPositions() const {
+                return positions;
+            }
+
+        private:
+            // A cell of the blocks of some rotations. The bit of a rotation is set if its blocks have the cell
+            struct Cell {
+                Point point;
+                int rotateBit;
+            };
+
+            const Factory &factory;
+            const bool classifies;
+
+            // The most rows that a kick moves down each piece
+            std::array<int, 7> maxKickDowns;
+
+            // The cells of the blocks of all rotations of each piece, without duplicates
+            std::array<std::vector<Cell>, 7> cells;
+
+            // The field, and the cells above the highest block of each column
+            PositionBoards boards;
+            PositionBoards skies;
+
+            std::array<PositionBoards, 4> harddropBoards;
+            ReachedPositions positions;
+
+            // The reached positions from which the rotations have been tried
+            std::array<PositionBoards, 4> rotatedBoards;
+
+            // The moves generated, in the rotations that `Piece::transforms` moves to
+            std::array<PositionBoards, 4> pushedBoards;
+
+            void load(const Field &field);
+
+            void generate(std::vector<Move> &moves, PieceType pieceType, int validHeight);
+
+            // The search with the positions of the first B boards, which cover the rows of the piece
+            template<size_t B>
+            void generate_(std::vector<Move> &moves, const Piece &piece, int validHeight, int numOfRows);
+
+            // Spreads the reached positions by moving down below the appearance, left and right
+            template<size_t B>
+            void fill(RotateType rotateType, const PositionBoards &below);
+
+            LastActions getLastAction(const Piece &piece, RotateType rotateType, int x, int y) const;
+
+            // Rotates the pending positions at once. Returns true if the rotations reach a new position
+            template<size_t B>
+            bool tryRotate(
+                    const Piece &piece, RotateType fromRotate, RotateType toRotate,
+                    const std::array<Offset, 20> &offsets, const PositionBoards &pending
+            );
+        };
+    }
+
     namespace srs_rotate_end {
         enum From {
             None,
@@ -115,6 +240,12 @@ namespace core {
 
             bool checks(const Field &field, PieceType pieceType, RotateType rotateType, int x, int y, int validHeight);
 
+            // Same as `checks` with the validHeight of the search, answered from its positions without searching again
+            bool checks(
+                    const srs_iterative::ReachedPositions &positions, PieceType pieceType, RotateType rotateType,
+                    int x, int y
+            ) const;
+
         private:
             const Factory &factory;
 
@@ -0,0 +1,132 @@
+#include <array>
+#include <algorithm>
+
+#include "path.hpp"
+
+namespace core {
+    namespace {
+        constexpr int kAppearX = 4;
+        constexpr int kNumOfStates = 4 * MAX_FIELD_HEIGHT * FIELD_WIDTH;
+
+        struct State {
+            RotateType rotateType;
+            int x;
+            int y;
+        };
+
+        int toIndex(const State &state) {
+            return (state.rotateType * MAX_FIELD_HEIGHT + state.y) * FIELD_WIDTH + state.x;
+        }
+
+        bool canPut(const Field &field, const Blocks &blocks, int x, int y) {
+            return -blocks.minX <= x && x < FIELD_WIDTH - blocks.maxX
+                   && -blocks.minY <= y && y < MAX_FIELD_HEIGHT - blocks.maxY
+                   && field.canPut(blocks, x, y);
+        }
+    }
+
+    bool findInputs(
+            std::vector<Inputs> &inputs, const Factory &factory, const Field &field,
+            PieceType pieceType, RotateType rotateType, int x, int y, int validHeight
+    ) {
+        auto &piece = factory.get(pieceType);
+
+        // The positions of the same shape are the same placement
+        auto &goalTransform = piece.transforms[rotateType];
+        auto goalRotateType = goalTransform.toRotate;
+        int goalX = x + goalTransform.offset.x;
+        int goalY = y + goalTransform.offset.y;
+
+        auto isGoal = [&](const State &state) {
+            auto &transform = piece.transforms[state.rotateType];
+            return transform.toRotate == goalRotateType && state.x + transform.offset.x == goalX
+                   && state.y + transform.offset.y == goalY;
+        };
+
+        inputs.clear();
+
+        auto appear = State{RotateType::Spawn, kAppearX, validHeight};
+        if (!canPut(field, piece.blocks[RotateType::Spawn], appear.x, appear.y)) {
+            return false;
+        }
+
+        // The input and the index of the state before each visited state
+        auto parents = std::array<int, kNumOfStates>{};
+        auto lastInputs = std::array<Inputs, kNumOfStates>{};
+        auto visited = std::array<bool, kNumOfStates>{};
+
+        auto queue = std::vector<State>{appear};
+        queue.reserve(kNumOfStates);
+        visited[toIndex(appear)] = true;
+        parents[toIndex(appear)] = -1;
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            auto current = queue[head];
+            int currentIndex = toIndex(current);
+
+            auto &blocks = piece.blocks[current.rotateType];
+
+            // The piece locks where it lands
+            int groundY = field.getYOnHarddrop(blocks, current.x, current.y);
+            if (isGoal(State{current.rotateType, current.x, groundY})) {
+                inputs.push_back(Inputs::HardDrop);
+                for (int index = currentIndex; parents[index] != -1; index = parents[index]) {
+                    inputs.push_back(lastInputs[index]);
+                }
+                std::reverse(inputs.begin(), inputs.end());
+                return true;
+            }
+
+            auto visit = [&](const State &next, Inputs input) {
+                int nextIndex = toIndex(next);
+                if (visited[nextIndex]) {
+                    return;
+                }
+                visited[nextIndex] = true;
+                parents[nextIndex] = currentIndex;
+                lastInputs[nextIndex] = input;
+                queue.push_back(next);
+            };
+
+            if (canPut(field, blocks, current.x - 1, current.y)) {
+                visit(State{current.rotateType, current.x - 1, current.y}, Inputs::ShiftLeft);
+            }
+
+            if (canPut(field, blocks, current.x + 1, current.y)) {
+                visit(State{current.rotateType, current.x + 1, current.y}, Inputs::ShiftRight);
+            }
+
+            {
+                auto toRotate = static_cast<RotateType>((current.rotateType + 1) % 4);
+                int index = srs::right(field, piece, current.rotateType, toRotate, current.x, current.y);
+                if (0 <= index) {
+                    auto &offset = piece.rightOffsets[index];
+                    int toX = current.x + offset.x;
+                    int toY = current.y + offset.y;
+                    if (canPut(field, piece.blocks[toRotate], toX, toY)) {
+                        visit(State{toRotate, toX, toY}, Inputs::RotateRight);
+                    }
+                }
+            }
+
+            {
+                auto toRotate = static_cast<RotateType>((current.rotateType + 3) % 4);
+                int index = srs::left(field, piece, current.rotateType, toRotate, current.x, current.y);
+                if (0 <= index) {
+                    auto &offset = piece.leftOffsets[index];
+                    int toX = current.x + offset.x;
+                    int toY = current.y + offset.y;
+                    if (canPut(field, piece.blocks[toRotate], toX, toY)) {
+                        visit(State{toRotate, toX, toY}, Inputs::RotateLeft);
+                    }
+                }
+            }
+
+            if (groundY < current.y) {
+                visit(State{current.rotateType, current.x, current.y - 1}, Inputs::SoftDrop);
+            }
+        }
+
+        return false;
+    }
+}
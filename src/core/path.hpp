@@ -0,0 +1,33 @@
+#ifndef CORE_PATH_HPP
+#define CORE_PATH_HPP
+
+#include <vector>
+
+#include "field.hpp"
+#include "srs.hpp"
+
+namespace core {
+    enum Inputs {
+        ShiftLeft = 0,
+        ShiftRight = 1,
+        RotateRight = 2,
+        RotateLeft = 3,
+        // Moves down by one row
+        SoftDrop = 4,
+        HardDrop = 5,
+    };
+
+    // Finds the fewest inputs that put the piece at the position, which ends with `HardDrop`.
+    // The piece appears in Spawn at (4, validHeight), and the kicks are those of `srs::right` and `srs::left`.
+    // This is narrower than the move generators, which take every free position at or above `validHeight`
+    // in any rotation as reached. A placement they return is not found here if it is reached only from such a position,
+    // e.g. when the appearance is blocked, or when it is too close to the top of the field for the piece to appear.
+    // Searches only the positions of the piece, so this is for the few placements of a solution, not for move generation.
+    // Returns false if the position cannot be reached from the appearance
+    bool findInputs(
+            std::vector<Inputs> &inputs, const Factory &factory, const Field &field,
+            PieceType pieceType, RotateType rotateType, int x, int y, int validHeight
+    );
+}
+
+#endif //CORE_PATH_HPP
@@ -0,0 +1,97 @@
+#ifndef FINDER_BATCH_HPP
+#define FINDER_BATCH_HPP
+
+#include <array>
+#include <map>
+
+#include "mirror.hpp"
+#include "perfect.hpp"
+#include "sequence_space.hpp"
+
+namespace finder {
+    struct Query {
+        core::Field field;
+        Sequence sequence;
+    };
+
+    // Finds a perfect clear for each query with `PerfectFinder`.
+    // A query and the query of the mirrored field and sequence have mirrored solutions,
+    // so each query is canonicalized to the smaller one of the pair, which is searched only once in a run,
+    // and the solution is mirrored back. A query with a piece whose kicks are not symmetric is searched as is
+    template<class T = core::srs::MoveGenerator>
+    class BatchFinder {
+    public:
+        BatchFinder<T>(const core::Factory &factory, T &moveGenerator)
+                : factory(factory), perfectFinder(PerfectFinder<T>(factory, moveGenerator)) {
+            for (int piece = 0; piece < 7; ++piece) {
+                symmetric[piece] = isMirrorSymmetric(factory, static_cast<core::PieceType>(piece));
+            }
+        }
+
+        // Returns the solution of each query, or `kNoSolution`
+        std::vector<Solution> run(const std::vector<Query> &queries, int maxDepth, int maxLine, bool holdEmpty);
+
+        // The number of searches in the last run
+        int numOfSearches() const {
+            return searches;
+        }
+
+    private:
+        using Key = std::pair<std::array<core::Bitboard, 4>, Sequence>;
+
+        const core::Factory &factory;
+        PerfectFinder<T> perfectFinder;
+        std::array<bool, 7> symmetric{};
+        int searches = 0;
+
+        static Key toKey(const core::Field &field, const Sequence &sequence) {
+            return Key{{field.getBoard(0), field.getBoard(1), field.getBoard(2), field.getBoard(3)}, sequence};
+        }
+    };
+
+    template<class T>
+    std::vector<Solution> BatchFinder<T>::run(
+            const std::vector<Query> &queries, int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        searches = 0;
+
+        std::map<Key, Solution> solutions{};
+        std::vector<Solution> results{};
+        results.reserve(queries.size());
+
+        for (const auto &query : queries) {
+            auto field = core::Field(query.field);
+            auto sequence = Sequence(query.sequence);
+            auto key = toKey(field, sequence);
+
+            bool mirrored = false;
+            if (std::all_of(sequence.begin(), sequence.end(), [&](core::PieceType piece) {
+                return symmetric[piece];
+            })) {
+                auto mirrorField = core::Field(field);
+                mirrorField.mirror();
+                auto mirrorSequence = mirror(sequence);
+                auto mirrorKey = toKey(mirrorField, mirrorSequence);
+                if (mirrorKey < key) {
+                    field = mirrorField;
+                    sequence = mirrorSequence;
+                    key = mirrorKey;
+                    mirrored = true;
+                }
+            }
+
+            auto it = solutions.find(key);
+            if (it == solutions.end()) {
+                searches += 1;
+                auto solution = perfectFinder.run(field, sequence, maxDepth, maxLine, holdEmpty);
+                it = solutions.emplace(key, solution).first;
+            }
+
+            results.push_back(mirrored ? mirror(factory, it->second) : it->second);
+        }
+
+        return results;
+    }
+}
+
+#endif //FINDER_BATCH_HPP
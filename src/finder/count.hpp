@@ -0,0 +1,152 @@
+#ifndef FINDER_COUNT_HPP
+#define FINDER_COUNT_HPP
+
+#include <unordered_map>
+
+#include "perfect.hpp"
+
+namespace finder {
+    // Counts the solutions that `EnumerateFinder` reports (without `unique`).
+    // The number of completions is memoized for each state, so that shared subtrees are counted once
+    template<class T = core::srs::MoveGenerator>
+    class CountFinder {
+    public:
+        CountFinder<T>(const core::Factory &factory, T &moveGenerator)
+                : factory(factory), moveGenerator(moveGenerator),
+                  counts(std::unordered_map<StateKey, uint64_t, StateKeyHasher>{}) {
+        }
+
+        uint64_t run(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty
+        );
+
+        // The number of memoized states in the last run
+        size_t states() const {
+            return counts.size();
+        }
+
+    private:
+        const core::Factory &factory;
+        T &moveGenerator;
+        std::unordered_map<StateKey, uint64_t, StateKeyHasher> counts;
+
+        uint64_t search(
+                const Configure &configure, const core::Field &field,
+                int currentIndex, int holdIndex, int leftLine, int depth
+        );
+
+        uint64_t move(
+                const Configure &configure, const core::Field &field, int leftLine, int depth,
+                core::PieceType pieceType, int nextIndex, int nextHoldIndex
+        );
+    };
+
+    template<class T>
+    uint64_t CountFinder<T>::search(
+            const Configure &configure, const core::Field &field,
+            int currentIndex, int holdIndex, int leftLine, int depth
+    ) {
+        auto key = StateKey{field, currentIndex, holdIndex};
+        auto it = counts.find(key);
+        if (it != counts.end()) {
+            return it->second;
+        }
+
+        auto &pieces = configure.pieces;
+        uint64_t count = 0;
+
+        bool canUseCurrent = currentIndex < configure.pieceSize;
+        if (canUseCurrent) {
+            auto &current = pieces[currentIndex];
+            count += move(configure, field, leftLine, depth, current, currentIndex + 1, holdIndex);
+        }
+
+        if (0 <= holdIndex) {
+            // Hold exists
+            if (!canUseCurrent || pieces[currentIndex] != pieces[holdIndex]) {
+                auto &hold = pieces[holdIndex];
+                count += move(configure, field, leftLine, depth, hold, currentIndex + 1, currentIndex);
+            }
+        } else {
+            assert(canUseCurrent);
+
+            // Empty hold
+            int nextIndex = currentIndex + 1;
+            if (nextIndex < configure.pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                auto &next = pieces[nextIndex];
+                count += move(configure, field, leftLine, depth, next, nextIndex + 1, currentIndex);
+            }
+        }
+
+        counts.emplace(key, count);
+
+        return count;
+    }
+
+    template<class T>
+    uint64_t CountFinder<T>::move(
+            const Configure &configure, const core::Field &field, int leftLine, int depth,
+            core::PieceType pieceType, int nextIndex, int nextHoldIndex
+    ) {
+        assert(0 < leftLine);
+
+        auto &moves = configure.movePool[depth];
+        moves.clear();
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        uint64_t count = 0;
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            auto freeze = core::Field(field);
+            freeze.put(blocks, move.x, move.y);
+
+            int numCleared = freeze.clearLineReturnNum();
+
+            int nextLeftLine = leftLine - numCleared;
+            if (nextLeftLine == 0) {
+                count += 1;
+                continue;
+            }
+
+            auto nextDepth = depth + 1;
+            if (configure.maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(freeze, nextLeftLine)) {
+                continue;
+            }
+
+            count += search(configure, freeze, nextIndex, nextHoldIndex, nextLeftLine, nextDepth);
+        }
+
+        return count;
+    }
+
+    template<class T>
+    uint64_t CountFinder<T>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        assert(1 <= maxDepth);
+
+        std::vector<std::vector<core::Move>> movePool(maxDepth);
+
+        const Configure configure{
+                pieces,
+                movePool,
+                maxDepth,
+                static_cast<int>(pieces.size()),
+        };
+
+        counts.clear();
+
+        return holdEmpty
+               ? search(configure, field, 0, -1, maxLine, 0)
+               : search(configure, field, 1, 0, maxLine, 0);
+    }
+}
+
+#endif //FINDER_COUNT_HPP
@@ -0,0 +1,168 @@
+#ifndef FINDER_ENUMERATE_HPP
+#define FINDER_ENUMERATE_HPP
+
+#include <unordered_set>
+
+#include "operation_with_key.hpp"
+#include "perfect.hpp"
+
+namespace finder {
+    template<class T = core::srs::MoveGenerator>
+    class EnumerateFinder {
+    public:
+        EnumerateFinder<T>(const core::Factory &factory, T &moveGenerator)
+                : factory(factory), moveGenerator(moveGenerator) {
+        }
+
+        // Calls `callback(const Solution &)` for each solution as soon as it is found, and returns the number of calls.
+        // If `unique` is true, solutions that have the same placements in a different order are reported only once
+        template<class F>
+        int64_t run(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty, bool unique, F &&callback
+        );
+
+    private:
+        const core::Factory &factory;
+        T &moveGenerator;
+
+        struct Context {
+            const core::Field &initField;
+            const bool unique;
+            std::unordered_set<SolutionWithKey, SolutionWithKeyHasher> foundKeys;
+            Solution found;
+            int64_t count;
+        };
+
+        template<class F>
+        void search(
+                const Configure &configure, Context &context, F &callback,
+                const core::Field &field, int currentIndex, int holdIndex, int leftLine, int depth,
+                Solution &solution
+        );
+
+        template<class F>
+        void move(
+                const Configure &configure, Context &context, F &callback,
+                const core::Field &field, int leftLine, int depth, Solution &solution,
+                core::PieceType pieceType, int nextIndex, int nextHoldIndex
+        );
+    };
+
+    template<class T>
+    template<class F>
+    void EnumerateFinder<T>::search(
+            const Configure &configure, Context &context, F &callback,
+            const core::Field &field, int currentIndex, int holdIndex, int leftLine, int depth,
+            Solution &solution
+    ) {
+        auto &pieces = configure.pieces;
+
+        bool canUseCurrent = currentIndex < configure.pieceSize;
+        if (canUseCurrent) {
+            auto &current = pieces[currentIndex];
+            move(configure, context, callback, field, leftLine, depth, solution, current, currentIndex + 1, holdIndex);
+        }
+
+        if (0 <= holdIndex) {
+            // Hold exists
+            if (!canUseCurrent || pieces[currentIndex] != pieces[holdIndex]) {
+                auto &hold = pieces[holdIndex];
+                move(configure, context, callback, field, leftLine, depth, solution, hold, currentIndex + 1, currentIndex);
+            }
+        } else {
+            assert(canUseCurrent);
+
+            // Empty hold
+            int nextIndex = currentIndex + 1;
+            if (nextIndex < configure.pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                auto &next = pieces[nextIndex];
+                move(configure, context, callback, field, leftLine, depth, solution, next, nextIndex + 1, currentIndex);
+            }
+        }
+    }
+
+    template<class T>
+    template<class F>
+    void EnumerateFinder<T>::move(
+            const Configure &configure, Context &context, F &callback,
+            const core::Field &field, int leftLine, int depth, Solution &solution,
+            core::PieceType pieceType, int nextIndex, int nextHoldIndex
+    ) {
+        assert(0 < leftLine);
+
+        auto &moves = configure.movePool[depth];
+        moves.clear();
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            auto freeze = core::Field(field);
+            freeze.put(blocks, move.x, move.y);
+
+            int numCleared = freeze.clearLineReturnNum();
+
+            solution[depth] = Operation{pieceType, move.rotateType, move.x, move.y};
+
+            int nextLeftLine = leftLine - numCleared;
+            if (nextLeftLine == 0) {
+                context.found.assign(solution.begin(), solution.begin() + depth + 1);
+
+                if (context.unique) {
+                    auto key = toSortedSolutionWithKey(factory, context.initField, context.found);
+                    if (!context.foundKeys.insert(key).second) {
+                        continue;
+                    }
+                }
+
+                context.count += 1;
+                callback(static_cast<const Solution &>(context.found));
+                continue;
+            }
+
+            auto nextDepth = depth + 1;
+            if (configure.maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(freeze, nextLeftLine)) {
+                continue;
+            }
+
+            search(configure, context, callback, freeze, nextIndex, nextHoldIndex, nextLeftLine, nextDepth, solution);
+        }
+    }
+
+    template<class T>
+    template<class F>
+    int64_t EnumerateFinder<T>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty, bool unique, F &&callback
+    ) {
+        assert(1 <= maxDepth);
+
+        std::vector<std::vector<core::Move>> movePool(maxDepth);
+
+        Solution solution(maxDepth);
+
+        const Configure configure{
+                pieces,
+                movePool,
+                maxDepth,
+                static_cast<int>(pieces.size()),
+        };
+
+        Context context{field, unique, std::unordered_set<SolutionWithKey, SolutionWithKeyHasher>{}, Solution{}, 0};
+
+        if (holdEmpty) {
+            search(configure, context, callback, field, 0, -1, maxLine, 0, solution);
+        } else {
+            search(configure, context, callback, field, 1, 0, maxLine, 0, solution);
+        }
+
+        return context.count;
+    }
+}
+
+#endif //FINDER_ENUMERATE_HPP
@@ -0,0 +1,18 @@
+#include "fewest.hpp"
+
+namespace finder {
+    int getHeight(const core::Field &field) {
+        for (int y = core::MAX_FIELD_HEIGHT - 1; 0 <= y; --y) {
+            auto row = field.getBoard(y / 6) >> ((y % 6) * core::FIELD_WIDTH);
+            if ((row & 0x3ffULL) != 0) {
+                return y + 1;
+            }
+        }
+        return 0;
+    }
+
+    int getNumOfAllBlocks(const core::Field &field) {
+        return core::bitCount(field.getBoard(0)) + core::bitCount(field.getBoard(1))
+               + core::bitCount(field.getBoard(2)) + core::bitCount(field.getBoard(3));
+    }
+}
@@ -0,0 +1,199 @@
+#ifndef FINDER_FEWEST_HPP
+#define FINDER_FEWEST_HPP
+
+#include <unordered_map>
+
+#include "perfect.hpp"
+
+namespace finder {
+    struct FewestResult {
+        int depth;  // -1 if no solution is found
+        int maxLine;
+        Solution solution;
+    };
+
+    int getHeight(const core::Field &field);
+
+    int getNumOfAllBlocks(const core::Field &field);
+
+    // Finds the fewest pieces for a perfect clear by iterative deepening over depth.
+    // A perfect clear of `maxLine` lines always uses (10 * maxLine - blocks) / 4 pieces, so each depth corresponds
+    // to at most one height. States that failed with a remaining depth are cached and shared across iterations
+    template<class T = core::srs::MoveGenerator, class P = LeastLineClearPriority>
+    class FewestFinder {
+    public:
+        FewestFinder<T, P>(const core::Factory &factory, T &moveGenerator)
+                : factory(factory), moveGenerator(moveGenerator), perfectFinder(factory, moveGenerator),
+                  failures(std::vector<std::unordered_map<StateKey, int, StateKeyHasher>>{}) {
+        }
+
+        // Returns the fewest depth and the best solution at that depth with the priority `P`
+        FewestResult run(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty
+        );
+
+    private:
+        const core::Factory &factory;
+        T &moveGenerator;
+        PerfectFinder<T, P> perfectFinder;
+
+        // The max remaining depth that failed for each state, indexed by the remaining lines
+        std::vector<std::unordered_map<StateKey, int, StateKeyHasher>> failures;
+
+        bool search(
+                const Configure &configure, const core::Field &field,
+                int currentIndex, int holdIndex, int leftLine, int depth
+        );
+
+        bool move(
+                const Configure &configure, const core::Field &field, int leftLine, int depth,
+                core::PieceType pieceType, int nextIndex, int nextHoldIndex
+        );
+    };
+
+    template<class T, class P>
+    bool FewestFinder<T, P>::search(
+            const Configure &configure, const core::Field &field,
+            int currentIndex, int holdIndex, int leftLine, int depth
+    ) {
+        int leftDepth = configure.maxDepth - depth;
+
+        auto &failure = failures[leftLine];
+        auto key = StateKey{field, currentIndex, holdIndex};
+        auto it = failure.find(key);
+        if (it != failure.end() && leftDepth <= it->second) {
+            return false;
+        }
+
+        auto &pieces = configure.pieces;
+
+        bool canUseCurrent = currentIndex < configure.pieceSize;
+        if (canUseCurrent) {
+            auto &current = pieces[currentIndex];
+            if (move(configure, field, leftLine, depth, current, currentIndex + 1, holdIndex)) {
+                return true;
+            }
+        }
+
+        if (0 <= holdIndex) {
+            // Hold exists
+            if (!canUseCurrent || pieces[currentIndex] != pieces[holdIndex]) {
+                auto &hold = pieces[holdIndex];
+                if (move(configure, field, leftLine, depth, hold, currentIndex + 1, currentIndex)) {
+                    return true;
+                }
+            }
+        } else {
+            assert(canUseCurrent);
+
+            // Empty hold
+            int nextIndex = currentIndex + 1;
+            if (nextIndex < configure.pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                auto &next = pieces[nextIndex];
+                if (move(configure, field, leftLine, depth, next, nextIndex + 1, currentIndex)) {
+                    return true;
+                }
+            }
+        }
+
+        // The iterator may be invalidated by the children
+        failure[key] = leftDepth;
+
+        return false;
+    }
+
+    template<class T, class P>
+    bool FewestFinder<T, P>::move(
+            const Configure &configure, const core::Field &field, int leftLine, int depth,
+            core::PieceType pieceType, int nextIndex, int nextHoldIndex
+    ) {
+        assert(0 < leftLine);
+
+        auto &moves = configure.movePool[depth];
+        moves.clear();
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            auto freeze = core::Field(field);
+            freeze.put(blocks, move.x, move.y);
+
+            int numCleared = freeze.clearLineReturnNum();
+
+            int nextLeftLine = leftLine - numCleared;
+            if (nextLeftLine == 0) {
+                return true;
+            }
+
+            auto nextDepth = depth + 1;
+            if (configure.maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(freeze, nextLeftLine)) {
+                continue;
+            }
+
+            if (search(configure, freeze, nextIndex, nextHoldIndex, nextLeftLine, nextDepth)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template<class T, class P>
+    FewestResult FewestFinder<T, P>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        assert(1 <= maxDepth);
+
+        std::vector<std::vector<core::Move>> movePool(maxDepth);
+
+        failures.assign(maxLine + 1, std::unordered_map<StateKey, int, StateKeyHasher>{});
+
+        int height = getHeight(field);
+        int numOfBlocks = getNumOfAllBlocks(field);
+
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            // The only height that is cleared by `depth` pieces
+            int cells = numOfBlocks + depth * 4;
+            if (cells % core::FIELD_WIDTH != 0) {
+                continue;
+            }
+
+            int line = cells / core::FIELD_WIDTH;
+            if (line < height || line == 0) {
+                continue;
+            }
+
+            if (maxLine < line) {
+                break;
+            }
+
+            const Configure configure{
+                    pieces,
+                    movePool,
+                    depth,
+                    static_cast<int>(pieces.size()),
+            };
+
+            bool found = holdEmpty
+                         ? search(configure, field, 0, -1, line, 0)
+                         : search(configure, field, 1, 0, line, 0);
+
+            if (found) {
+                auto solution = perfectFinder.run(field, pieces, depth, line, holdEmpty);
+                assert(!solution.empty());
+                return FewestResult{depth, line, solution};
+            }
+        }
+
+        return FewestResult{-1, -1, kNoSolution};
+    }
+}
+
+#endif //FINDER_FEWEST_HPP
@@ -0,0 +1,175 @@
+#ifndef FINDER_FIXED_HPP
+#define FINDER_FIXED_HPP
+
+#include <unordered_set>
+
+#include "perfect.hpp"
+
+namespace finder {
+    // Finds a perfect clear without shifting the rows of the field.
+    // Filled rows stay in place and are tracked as a `LineKey`, and pieces are searched in the field with the rows
+    // deleted. A state is the occupancy in the coordinates of the initial field, so the same arrangement reached
+    // through different line clears is searched once
+    template<class T = core::srs::MoveGenerator>
+    class FixedRowsFinder {
+    public:
+        FixedRowsFinder<T>(const core::Factory &factory, T &moveGenerator)
+                : factory(factory), moveGenerator(moveGenerator),
+                  failures(std::unordered_set<StateKey, StateKeyHasher>{}) {
+        }
+
+        // Returns the first solution found. As `PerfectFinder`, the coordinates are in the field after line clears
+        Solution run(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty
+        );
+
+        // The number of failed states in the last run
+        size_t states() const {
+            return failures.size();
+        }
+
+    private:
+        const core::Factory &factory;
+        T &moveGenerator;
+        std::unordered_set<StateKey, StateKeyHasher> failures;
+
+        // `fixed` is the field in the initial coordinates, and `field` is `fixed` without the rows of `deletedKey`
+        bool search(
+                const Configure &configure, const core::Field &fixed, const core::Field &field, core::LineKey deletedKey,
+                int currentIndex, int holdIndex, int leftLine, int depth, Solution &solution
+        );
+
+        bool move(
+                const Configure &configure, const core::Field &field, core::LineKey deletedKey,
+                int leftLine, int depth, Solution &solution,
+                core::PieceType pieceType, int nextIndex, int nextHoldIndex
+        );
+    };
+
+    template<class T>
+    bool FixedRowsFinder<T>::search(
+            const Configure &configure, const core::Field &fixed, const core::Field &field, core::LineKey deletedKey,
+            int currentIndex, int holdIndex, int leftLine, int depth, Solution &solution
+    ) {
+        auto key = StateKey{fixed, currentIndex, holdIndex};
+        if (failures.find(key) != failures.end()) {
+            return false;
+        }
+
+        auto &pieces = configure.pieces;
+
+        bool canUseCurrent = currentIndex < configure.pieceSize;
+        if (canUseCurrent) {
+            auto &current = pieces[currentIndex];
+            if (move(configure, field, deletedKey, leftLine, depth, solution, current, currentIndex + 1, holdIndex)) {
+                return true;
+            }
+        }
+
+        if (0 <= holdIndex) {
+            // Hold exists
+            if (!canUseCurrent || pieces[currentIndex] != pieces[holdIndex]) {
+                auto &hold = pieces[holdIndex];
+                if (move(configure, field, deletedKey, leftLine, depth, solution, hold, currentIndex + 1, currentIndex)) {
+                    return true;
+                }
+            }
+        } else {
+            assert(canUseCurrent);
+
+            // Empty hold
+            int nextIndex = currentIndex + 1;
+            if (nextIndex < configure.pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                auto &next = pieces[nextIndex];
+                if (move(configure, field, deletedKey, leftLine, depth, solution, next, nextIndex + 1, currentIndex)) {
+                    return true;
+                }
+            }
+        }
+
+        failures.insert(key);
+
+        return false;
+    }
+
+    template<class T>
+    bool FixedRowsFinder<T>::move(
+            const Configure &configure, const core::Field &field, core::LineKey deletedKey,
+            int leftLine, int depth, Solution &solution,
+            core::PieceType pieceType, int nextIndex, int nextHoldIndex
+    ) {
+        assert(0 < leftLine);
+
+        auto &moves = configure.movePool[depth];
+        moves.clear();
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            // Back to the initial coordinates. The deleted rows are filled
+            auto nextFixed = core::Field(field);
+            nextFixed.put(blocks, move.x, move.y);
+            nextFixed.insertBlackLineWithKey(deletedKey);
+
+            auto nextField = core::Field(nextFixed);
+            auto nextDeletedKey = nextField.clearLineReturnKey();
+            int nextLeftLine = leftLine - (core::bitCount(nextDeletedKey) - core::bitCount(deletedKey));
+
+            solution[depth] = Operation{pieceType, move.rotateType, move.x, move.y};
+
+            if (nextLeftLine == 0) {
+                solution.resize(depth + 1);
+                return true;
+            }
+
+            auto nextDepth = depth + 1;
+            if (configure.maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(nextField, nextLeftLine)) {
+                continue;
+            }
+
+            if (search(
+                    configure, nextFixed, nextField, nextDeletedKey,
+                    nextIndex, nextHoldIndex, nextLeftLine, nextDepth, solution
+            )) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template<class T>
+    Solution FixedRowsFinder<T>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        assert(1 <= maxDepth);
+
+        std::vector<std::vector<core::Move>> movePool(maxDepth);
+
+        const Configure configure{
+                pieces,
+                movePool,
+                maxDepth,
+                static_cast<int>(pieces.size()),
+        };
+
+        failures.clear();
+
+        Solution solution(maxDepth);
+
+        bool found = holdEmpty
+                     ? search(configure, field, field, 0, 0, -1, maxLine, 0, solution)
+                     : search(configure, field, field, 0, 1, 0, maxLine, 0, solution);
+
+        return found ? solution : kNoSolution;
+    }
+}
+
+#endif //FINDER_FIXED_HPP
@@ -0,0 +1,104 @@
+#include "mirror.hpp"
+
+namespace finder {
+    namespace {
+        const core::PieceType kMirrorPieceTypes[7] = {
+                core::PieceType::T, core::PieceType::I, core::PieceType::J, core::PieceType::L,
+                core::PieceType::Z, core::PieceType::S, core::PieceType::O,
+        };
+
+        const core::RotateType kMirrorRotateTypes[4] = {
+                core::RotateType::Spawn, core::RotateType::Left, core::RotateType::Reverse, core::RotateType::Right,
+        };
+
+        // Returns true if the kicks from `rotateType` in one direction are the flipped kicks of the mirrored piece
+        bool isMirrorSymmetric(
+                const core::Piece &piece, const core::Piece &mirrorPiece, core::RotateType fromRotate,
+                core::RotateType toRotate, const std::array<core::Offset, 20> &offsets,
+                const std::array<core::Offset, 20> &mirrorOffsets
+        ) {
+            auto &fromBlocks = piece.blocks[fromRotate];
+            auto &toBlocks = piece.blocks[toRotate];
+            auto &mirrorFromBlocks = mirrorPiece.blocks[mirror(fromRotate)];
+            auto &mirrorToBlocks = mirrorPiece.blocks[mirror(toRotate)];
+
+            // The kicks move the origin, and the origins of the flipped blocks are shifted by their extents
+            int shiftX = fromBlocks.maxX + mirrorFromBlocks.minX - toBlocks.maxX - mirrorToBlocks.minX;
+            int shiftY = mirrorFromBlocks.minY - fromBlocks.minY + toBlocks.minY - mirrorToBlocks.minY;
+
+            int head = fromRotate * 5;
+            int mirrorHead = mirror(fromRotate) * 5;
+            for (int index = 0; index < static_cast<int>(piece.offsetsSize); ++index) {
+                auto &offset = offsets[head + index];
+                auto &mirrorOffset = mirrorOffsets[mirrorHead + index];
+                if (mirrorOffset.x != -offset.x + shiftX || mirrorOffset.y != offset.y + shiftY) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    core::PieceType mirror(core::PieceType pieceType) {
+        return kMirrorPieceTypes[pieceType];
+    }
+
+    core::RotateType mirror(core::RotateType rotateType) {
+        return kMirrorRotateTypes[rotateType];
+    }
+
+    Operation mirror(const core::Factory &factory, const Operation &operation) {
+        auto &blocks = factory.get(operation.pieceType, operation.rotateType);
+
+        auto pieceType = mirror(operation.pieceType);
+        auto rotateType = mirror(operation.rotateType);
+        auto &mirrorBlocks = factory.get(pieceType, rotateType);
+
+        // The leftmost column of the flipped blocks is the rightmost column of the blocks
+        int x = core::FIELD_WIDTH - 1 - (operation.x + blocks.maxX) - mirrorBlocks.minX;
+        int y = operation.y + blocks.minY - mirrorBlocks.minY;
+
+        auto &transform = factory.get(pieceType).transforms[rotateType];
+        return Operation{pieceType, transform.toRotate, x + transform.offset.x, y + transform.offset.y};
+    }
+
+    Solution mirror(const core::Factory &factory, const Solution &solution) {
+        auto result = Solution{};
+        result.reserve(solution.size());
+        for (const auto &operation : solution) {
+            result.push_back(mirror(factory, operation));
+        }
+        return result;
+    }
+
+    Sequence mirror(const Sequence &sequence) {
+        auto result = Sequence{};
+        result.reserve(sequence.size());
+        for (auto pieceType : sequence) {
+            result.push_back(mirror(pieceType));
+        }
+        return result;
+    }
+
+    bool isMirrorSymmetric(const core::Factory &factory, core::PieceType pieceType) {
+        auto &piece = factory.get(pieceType);
+        auto &mirrorPiece = factory.get(mirror(pieceType));
+
+        if (piece.offsetsSize != mirrorPiece.offsetsSize) {
+            return false;
+        }
+
+        for (int rotate = 0; rotate < 4; ++rotate) {
+            auto fromRotate = static_cast<core::RotateType>(rotate);
+            auto right = static_cast<core::RotateType>((rotate + 1) % 4);
+            auto left = static_cast<core::RotateType>((rotate + 3) % 4);
+            if (!isMirrorSymmetric(piece, mirrorPiece, fromRotate, right, piece.rightOffsets, mirrorPiece.leftOffsets)
+                || !isMirrorSymmetric(piece, mirrorPiece, fromRotate, left, piece.leftOffsets, mirrorPiece.rightOffsets)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef FINDER_MIRROR_HPP
+#define FINDER_MIRROR_HPP
+
+#include "perfect.hpp"
+#include "sequence_space.hpp"
+
+namespace finder {
+    // L <-> J, S <-> Z
+    core::PieceType mirror(core::PieceType pieceType);
+
+    // Right <-> Left
+    core::RotateType mirror(core::RotateType rotateType);
+
+    // The operation that puts the flipped blocks on the flipped field. The rotation is normalized
+    Operation mirror(const core::Factory &factory, const Operation &operation);
+
+    Solution mirror(const core::Factory &factory, const Solution &solution);
+
+    Sequence mirror(const Sequence &sequence);
+
+    // Returns true if every kick of the piece is the flipped kick of its mirrored piece in the opposite direction,
+    // in the same order. Then the piece reaches the flipped placements on the flipped field.
+    // The SRS kicks of I are not symmetric
+    bool isMirrorSymmetric(const core::Factory &factory, core::PieceType pieceType);
+}
+
+#endif //FINDER_MIRROR_HPP
@@ -0,0 +1,76 @@
+#include "operation_with_key.hpp"
+
+namespace finder {
+    namespace {
+        core::LineKey getLineKey(int y) {
+            return 1ULL << ((y % 6) * core::FIELD_WIDTH + y / 6);
+        }
+
+        // Returns the row in the initial field of the row `y` in the field without the deleted rows
+        int toInitialY(core::LineKey deletedKey, int y) {
+            int initialY = 0;
+            for (int left = y; ; ++initialY) {
+                if ((deletedKey & getLineKey(initialY)) == 0) {
+                    if (left == 0) {
+                        return initialY;
+                    }
+                    left -= 1;
+                }
+            }
+        }
+    }
+
+    SolutionWithKey toSolutionWithKey(const core::Factory &factory, const core::Field &field, const Solution &solution) {
+        auto fixed = core::Field(field);
+        auto result = SolutionWithKey{};
+        result.reserve(solution.size());
+
+        for (const auto &operation : solution) {
+            auto freeze = core::Field(fixed);
+            auto deletedKey = freeze.clearLineReturnKey();
+
+            auto &piece = factory.get(operation.pieceType);
+            auto &transform = piece.transforms[operation.rotateType];
+            auto rotateType = transform.toRotate;
+            int x = operation.x + transform.offset.x;
+            int y = operation.y + transform.offset.y;
+
+            auto &blocks = factory.get(operation.pieceType, rotateType);
+
+            int lowerY = toInitialY(deletedKey, y + blocks.minY);
+            int upperY = toInitialY(deletedKey, y + blocks.maxY);
+            core::LineKey needDeletedKey = 0;
+            for (int row = lowerY + 1; row < upperY; ++row) {
+                needDeletedKey |= deletedKey & getLineKey(row);
+            }
+
+            result.push_back(OperationWithKey{
+                    operation.pieceType, rotateType, x, toInitialY(deletedKey, y), needDeletedKey
+            });
+
+            // The deleted rows are filled
+            freeze.put(blocks, x, y);
+            freeze.insertBlackLineWithKey(deletedKey);
+            fixed = freeze;
+        }
+
+        return result;
+    }
+
+    SolutionWithKey toSortedSolutionWithKey(
+            const core::Factory &factory, const core::Field &field, const Solution &solution
+    ) {
+        auto result = toSolutionWithKey(factory, field, solution);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    size_t SolutionWithKeyHasher::operator()(const SolutionWithKey &solution) const noexcept {
+        auto hasher = std::hash<OperationWithKey>{};
+        uint64_t hash = solution.size();
+        for (const auto &operation : solution) {
+            hash = hash * 0x9e3779b97f4a7c15ULL + hasher(operation);
+        }
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+}
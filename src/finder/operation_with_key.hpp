@@ -0,0 +1,63 @@
+#ifndef FINDER_OPERATION_WITH_KEY_HPP
+#define FINDER_OPERATION_WITH_KEY_HPP
+
+#include "perfect.hpp"
+
+namespace finder {
+    // An operation in the coordinates of the initial field.
+    // The rows between its blocks that are not used by it must be cleared before, as `needDeletedKey`
+    struct OperationWithKey {
+        core::PieceType pieceType;
+        core::RotateType rotateType;
+        int x;
+        int y;
+        core::LineKey needDeletedKey;  // The layout of `Field::clearLineReturnKey`
+    };
+
+    inline bool operator==(const OperationWithKey &lhs, const OperationWithKey &rhs) {
+        return lhs.pieceType == rhs.pieceType && lhs.rotateType == rhs.rotateType && lhs.x == rhs.x
+               && lhs.y == rhs.y && lhs.needDeletedKey == rhs.needDeletedKey;
+    }
+
+    inline bool operator!=(const OperationWithKey &lhs, const OperationWithKey &rhs) {
+        return !(lhs == rhs);
+    }
+
+    inline bool operator<(const OperationWithKey &lhs, const OperationWithKey &rhs) {
+        if (lhs.pieceType != rhs.pieceType) return lhs.pieceType < rhs.pieceType;
+        if (lhs.rotateType != rhs.rotateType) return lhs.rotateType < rhs.rotateType;
+        if (lhs.x != rhs.x) return lhs.x < rhs.x;
+        if (lhs.y != rhs.y) return lhs.y < rhs.y;
+        return lhs.needDeletedKey < rhs.needDeletedKey;
+    }
+
+    using SolutionWithKey = std::vector<OperationWithKey>;
+
+    // Converts the operations to the initial coordinates in the same order. Rotations are normalized
+    SolutionWithKey toSolutionWithKey(const core::Factory &factory, const core::Field &field, const Solution &solution);
+
+    // The same for all orders of the same placements: sorted operations with keys
+    SolutionWithKey toSortedSolutionWithKey(
+            const core::Factory &factory, const core::Field &field, const Solution &solution
+    );
+
+    struct SolutionWithKeyHasher {
+        size_t operator()(const SolutionWithKey &solution) const noexcept;
+    };
+}
+
+namespace std {
+    template<>
+    struct hash<finder::OperationWithKey> {
+        size_t operator()(const finder::OperationWithKey &operation) const noexcept {
+            uint64_t hash = operation.pieceType;
+            hash = hash * 4 + operation.rotateType;
+            hash = hash * 16 + operation.x;
+            hash = hash * 32 + operation.y;
+            hash = hash * 0x9e3779b97f4a7c15ULL + operation.needDeletedKey;
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+}
+
+#endif //FINDER_OPERATION_WITH_KEY_HPP
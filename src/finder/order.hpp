@@ -0,0 +1,289 @@
+#ifndef FINDER_ORDER_HPP
+#define FINDER_ORDER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include "perfect.hpp"
+
+namespace finder {
+    // A piece placed in the coordinates of the initial field.
+    // The rows between its blocks that it does not use must be cleared before it is placed
+    struct Placement {
+        core::PieceType pieceType;
+        core::RotateType rotateType;
+        int x;
+        core::Bitboard cells;  // The same layout as `Field::getBoard(0)`
+        int usingRows;  // Bits at y
+        int deletedRows;  // Bits at y
+    };
+
+    using PlacementSet = std::vector<Placement>;
+
+    // The placements reachable after a union of placements is put on the initial field.
+    // Keyed by the placed cells and the piece, so the same partial fillings share one search across placement sets
+    template<class T = core::srs::MoveGenerator>
+    class PlacedCellsCache {
+    public:
+        PlacedCellsCache<T>(const core::Factory &factory, T &moveGenerator, const core::Field &field, int maxLine)
+                : factory(factory), moveGenerator(moveGenerator), field(field), maxLine(maxLine) {
+            assert(1 <= maxLine && maxLine <= 6);
+        }
+
+        // Bits at y of the rows that are filled after the cells are placed
+        int getClearedRows(core::Bitboard placedCells) const;
+
+        // The y of the placement in the field after the cells are placed and the filled rows are cleared
+        int getY(core::Bitboard placedCells, const Placement &placement) const;
+
+        // Returns true if the piece can reach the placement after the cells are placed
+        bool isReachable(core::Bitboard placedCells, const Placement &placement);
+
+        // The number of searches by the move generator
+        int numOfSearches() const {
+            return static_cast<int>(reachable.size());
+        }
+
+    private:
+        const core::Factory &factory;
+        T &moveGenerator;
+        const core::Field field;
+        const int maxLine;
+
+        // Sorted codes of the moves, keyed by the placed cells and the piece
+        std::unordered_map<uint64_t, std::vector<uint16_t>> reachable;
+        std::vector<core::Move> moves;
+
+        static int toCode(core::RotateType rotateType, int x, int y) {
+            return (rotateType * core::MAX_FIELD_HEIGHT + y) * core::FIELD_WIDTH + x;
+        }
+    };
+
+    template<class T>
+    int PlacedCellsCache<T>::getClearedRows(core::Bitboard placedCells) const {
+        auto board = field.getBoard(0) | placedCells;
+        int rows = 0;
+        for (int y = 0; y < maxLine; ++y) {
+            if (((board >> (y * core::FIELD_WIDTH)) & 0x3ffULL) == 0x3ffULL) {
+                rows |= 1 << y;
+            }
+        }
+        return rows;
+    }
+
+    template<class T>
+    int PlacedCellsCache<T>::getY(core::Bitboard placedCells, const Placement &placement) const {
+        int rows = getClearedRows(placedCells);
+        int lowerRow = placement.usingRows & -placement.usingRows;
+        int lowerY = core::bitCount(lowerRow - 1) - core::bitCount(rows & (lowerRow - 1));
+        return lowerY - factory.get(placement.pieceType, placement.rotateType).minY;
+    }
+
+    template<class T>
+    bool PlacedCellsCache<T>::isReachable(core::Bitboard placedCells, const Placement &placement) {
+        int rows = getClearedRows(placedCells);
+        if ((placement.deletedRows & ~rows) != 0) {
+            return false;
+        }
+
+        // The cells are below 60 bits
+        auto key = (placedCells << 3) | placement.pieceType;
+        auto it = reachable.find(key);
+        if (it == reachable.end()) {
+            auto freeze = core::Field(field);
+            freeze.putBoard(0, placedCells);
+            freeze.clearLine();
+
+            moves.clear();
+            moveGenerator.search(moves, freeze, placement.pieceType, maxLine - core::bitCount(rows));
+
+            auto codes = std::vector<uint16_t>{};
+            codes.reserve(moves.size());
+            for (const auto &move : moves) {
+                codes.push_back(static_cast<uint16_t>(toCode(move.rotateType, move.x, move.y)));
+            }
+            std::sort(codes.begin(), codes.end());
+
+            it = reachable.emplace(key, std::move(codes)).first;
+        }
+
+        int y = getY(placedCells, placement);
+        auto code = static_cast<uint16_t>(toCode(placement.rotateType, placement.x, y));
+        return std::binary_search(it->second.begin(), it->second.end(), code);
+    }
+
+    // Decides whether a placement set can be placed in some order with a queue, by DP over the subsets of placed pieces.
+    // The reachable placements do not depend on the queue, so they are cached by `PlacedCellsCache`,
+    // which can be shared by the finders of other sets on the same field. The set is copied
+    template<class T = core::srs::MoveGenerator>
+    class OrderFinder {
+    public:
+        // Uses its own cache
+        OrderFinder<T>(
+                const core::Factory &factory, T &moveGenerator, const core::Field &field, int maxLine,
+                const PlacementSet &set
+        ) : ownedCache(std::make_unique<PlacedCellsCache<T>>(factory, moveGenerator, field, maxLine)),
+            cache(*ownedCache), set(set), numOfPlacements(static_cast<int>(set.size())) {
+            assert(numOfPlacements <= 15);
+        }
+
+        OrderFinder<T>(PlacedCellsCache<T> &cache, const PlacementSet &set)
+                : cache(cache), set(set), numOfPlacements(static_cast<int>(set.size())) {
+            assert(numOfPlacements <= 15);
+        }
+
+        // Returns the operations in the order of placement, or `kNoSolution`.
+        // As `PerfectFinder`, the coordinates are in the field at the time each piece is placed
+        Solution run(const std::vector<core::PieceType> &pieces, bool holdEmpty);
+
+    private:
+        static constexpr int kEmptyHold = 7;
+
+        // The parent of a state: the last placement and the hold before it
+        struct Parent {
+            int8_t index;
+            int8_t hold;
+        };
+
+        std::unique_ptr<PlacedCellsCache<T>> ownedCache;
+        PlacedCellsCache<T> &cache;
+        const PlacementSet set;
+        const int numOfPlacements;
+
+        core::Bitboard getCells(int placed) const {
+            core::Bitboard cells = 0;
+            for (int index = 0; index < numOfPlacements; ++index) {
+                if ((placed & (1 << index)) != 0) {
+                    cells |= set[index].cells;
+                }
+            }
+            return cells;
+        }
+    };
+
+    template<class T>
+    Solution OrderFinder<T>::run(const std::vector<core::PieceType> &pieces, bool holdEmpty) {
+        int numOfStates = 1 << numOfPlacements;
+        int full = numOfStates - 1;
+        int pieceSize = static_cast<int>(pieces.size());
+
+        // Hold pieces reached for each subset as bits
+        std::vector<uint8_t> holds(numOfStates, 0);
+        std::vector<Parent> parents(numOfStates * 8);
+
+        if (holdEmpty) {
+            holds[0] = 1 << kEmptyHold;
+        } else if (0 < pieceSize) {
+            holds[0] = 1 << pieces[0];
+        }
+
+        int goalHold = -1;
+
+        // Placing a piece adds a bit, so all parents of a subset are smaller
+        for (int placed = 0; placed < full && goalHold < 0; ++placed) {
+            if (holds[placed] == 0) {
+                continue;
+            }
+
+            int depth = core::bitCount(placed);
+            auto placedCells = getCells(placed);
+
+            for (int hold = 0; hold < 8 && goalHold < 0; ++hold) {
+                if ((holds[placed] & (1 << hold)) == 0) {
+                    continue;
+                }
+
+                int currentIndex = hold == kEmptyHold ? depth : depth + 1;
+                bool canUseCurrent = currentIndex < pieceSize;
+
+                // Returns true if reaches the goal
+                auto transit = [&](core::PieceType pieceType, int nextHold) {
+                    for (int index = 0; index < numOfPlacements; ++index) {
+                        int bit = 1 << index;
+                        if ((placed & bit) != 0 || set[index].pieceType != pieceType) {
+                            continue;
+                        }
+
+                        int next = placed | bit;
+
+                        // No piece is left to hold after the last one
+                        if (nextHold < 0 && next != full) {
+                            continue;
+                        }
+
+                        if (!cache.isReachable(placedCells, set[index])) {
+                            continue;
+                        }
+
+                        int key = nextHold < 0 ? kEmptyHold : nextHold;
+                        if ((holds[next] & (1 << key)) != 0) {
+                            continue;
+                        }
+
+                        holds[next] |= 1 << key;
+                        parents[next * 8 + key] = Parent{static_cast<int8_t>(index), static_cast<int8_t>(hold)};
+
+                        if (next == full) {
+                            goalHold = key;
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+
+                if (canUseCurrent) {
+                    if (transit(pieces[currentIndex], hold)) {
+                        break;
+                    }
+                }
+
+                if (hold != kEmptyHold) {
+                    // Hold exists
+                    if (!canUseCurrent || pieces[currentIndex] != hold) {
+                        int nextHold = canUseCurrent ? pieces[currentIndex] : -1;
+                        if (transit(static_cast<core::PieceType>(hold), nextHold)) {
+                            break;
+                        }
+                    }
+                } else if (canUseCurrent) {
+                    // Empty hold
+                    int nextIndex = currentIndex + 1;
+                    if (nextIndex < pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                        if (transit(pieces[nextIndex], pieces[currentIndex])) {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (goalHold < 0) {
+            return kNoSolution;
+        }
+
+        // Trace back the parents
+        std::vector<int> order(numOfPlacements);
+        int placed = full;
+        int hold = goalHold;
+        for (int depth = numOfPlacements - 1; 0 <= depth; --depth) {
+            auto &parent = parents[placed * 8 + hold];
+            order[depth] = parent.index;
+            placed ^= 1 << parent.index;
+            hold = parent.hold;
+        }
+
+        Solution solution(numOfPlacements);
+        placed = 0;
+        for (int depth = 0; depth < numOfPlacements; ++depth) {
+            auto &placement = set[order[depth]];
+            int y = cache.getY(getCells(placed), placement);
+            solution[depth] = Operation{placement.pieceType, placement.rotateType, placement.x, y};
+            placed |= 1 << order[depth];
+        }
+
+        return solution;
+    }
+}
+
+#endif //FINDER_ORDER_HPP
@@ -0,0 +1,92 @@
+#include "pack.hpp"
+
+namespace finder {
+    namespace {
+        int getLowestIndex(core::Bitboard board) {
+            return core::bitCount((board & (~board + 1)) - 1);
+        }
+    }
+
+    core::Bitboard getEmptyCells(const core::Field &field, int maxLine) {
+        assert(1 <= maxLine && maxLine <= 6);
+
+        core::Bitboard area = maxLine == 6 ? 0xfffffffffffffffULL : (1ULL << (maxLine * core::FIELD_WIDTH)) - 1;
+        assert((field.getBoard(0) & ~area) == 0);
+        assert(field.getBoard(1) == 0 && field.getBoard(2) == 0 && field.getBoard(3) == 0);
+
+        return ~field.getBoard(0) & area;
+    }
+
+    std::vector<std::vector<Placement>> findPlacements(
+            const core::Factory &factory, const core::Field &field, int maxLine
+    ) {
+        core::Bitboard empty = getEmptyCells(field, maxLine);
+
+        std::vector<std::vector<Placement>> candidates(maxLine * core::FIELD_WIDTH);
+
+        for (int type = 0; type < 7; ++type) {
+            auto pieceType = static_cast<core::PieceType>(type);
+            auto &piece = factory.get(pieceType);
+
+            for (int rotate = 0; rotate < 4; ++rotate) {
+                if ((piece.uniqueRotateBit & (1 << rotate)) == 0) {
+                    continue;
+                }
+
+                auto rotateType = static_cast<core::RotateType>(rotate);
+                auto &blocks = factory.get(pieceType, rotateType);
+
+                // Each row of the piece is mapped to one of the rows in the field
+                for (int usingRows = 1; usingRows < (1 << maxLine); ++usingRows) {
+                    if (core::bitCount(usingRows) != blocks.height) {
+                        continue;
+                    }
+
+                    int rows[4];
+                    int numOfRows = 0;
+                    for (int y = 0; y < maxLine; ++y) {
+                        if ((usingRows & (1 << y)) != 0) {
+                            rows[numOfRows] = y;
+                            numOfRows += 1;
+                        }
+                    }
+
+                    int span = (1 << (rows[numOfRows - 1] + 1)) - (1 << rows[0]);
+                    int deletedRows = span & ~usingRows;
+
+                    for (int x = -blocks.minX; x < core::FIELD_WIDTH - blocks.maxX; ++x) {
+                        core::Bitboard cells = 0;
+                        for (const auto &point : blocks.points) {
+                            int y = rows[point.y - blocks.minY];
+                            cells |= 1ULL << (x + point.x + y * core::FIELD_WIDTH);
+                        }
+
+                        if ((cells & ~empty) != 0) {
+                            continue;
+                        }
+
+                        candidates[getLowestIndex(cells)].push_back(
+                                Placement{pieceType, rotateType, x, cells, usingRows, deletedRows}
+                        );
+                    }
+                }
+            }
+        }
+
+        return candidates;
+    }
+
+    std::vector<PlacementSet> findPlacementSets(const core::Factory &factory, const core::Field &field, int maxLine) {
+        auto counts = std::array<int, 7>{};
+        counts.fill(INT_MAX);
+
+        auto sets = std::vector<PlacementSet>{};
+        forEachPlacementSet(findPlacements(factory, field, maxLine), getEmptyCells(field, maxLine), counts, [&](
+                const PlacementSet &set
+        ) {
+            sets.push_back(set);
+            return false;
+        });
+        return sets;
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef FINDER_PACK_HPP
+#define FINDER_PACK_HPP
+
+#include <algorithm>
+#include <array>
+#include <unordered_set>
+
+#include "order.hpp"
+#include "perfect.hpp"
+
+namespace finder {
+    // The empty cells below `maxLine` (up to 6) in the layout of `Field::getBoard(0)`
+    core::Bitboard getEmptyCells(const core::Field &field, int maxLine);
+
+    // The placements that fit in the empty cells below `maxLine`, indexed by their lowest cell
+    std::vector<std::vector<Placement>> findPlacements(const core::Factory &factory, const core::Field &field, int maxLine);
+
+    namespace pack {
+        // The cells and the pieces left while the sets are enumerated
+        struct CoverKey {
+            core::Bitboard left;
+            uint32_t counts;
+        };
+
+        inline bool operator==(const CoverKey &lhs, const CoverKey &rhs) {
+            return lhs.left == rhs.left && lhs.counts == rhs.counts;
+        }
+
+        struct CoverKeyHasher {
+            size_t operator()(const CoverKey &key) const noexcept {
+                return std::hash<core::Bitboard>{}(key.left) ^ static_cast<size_t>(key.counts) * 31;
+            }
+        };
+
+        // The states from which no set covers the cells left
+        using DeadEnds = std::unordered_set<CoverKey, CoverKeyHasher>;
+
+        // 4 bits for each piece. No more than 15 placements fit below 6 lines, so larger counts are the same as 15
+        inline uint32_t toCountsKey(const std::array<int, 7> &counts) {
+            uint32_t key = 0;
+            for (int count : counts) {
+                key = (key << 4) | static_cast<uint32_t>(std::min(count, 15));
+            }
+            return key;
+        }
+
+        // Returns 1 if `callback` stopped the enumeration, 0 if some set was found, and -1 if no set was found
+        template<class F>
+        int forEachPlacementSet(
+                const std::vector<std::vector<Placement>> &placements, core::Bitboard left, std::array<int, 7> &counts,
+                PlacementSet &set, DeadEnds &deadEnds, F &callback
+        ) {
+            if (left == 0) {
+                return callback(static_cast<const PlacementSet &>(set)) ? 1 : 0;
+            }
+
+            auto key = CoverKey{left, toCountsKey(counts)};
+            if (deadEnds.find(key) != deadEnds.end()) {
+                return -1;
+            }
+
+            // The lowest empty cell must be the lowest cell of the next placement
+            int lowest = core::bitCount((left & (~left + 1)) - 1);
+            int result = -1;
+            bool tried = false;
+            for (const auto &placement : placements[lowest]) {
+                if ((placement.cells & ~left) != 0 || counts[placement.pieceType] == 0) {
+                    continue;
+                }
+
+                tried = true;
+                counts[placement.pieceType] -= 1;
+                set.push_back(placement);
+                int next = forEachPlacementSet(placements, left & ~placement.cells, counts, set, deadEnds, callback);
+                set.pop_back();
+                counts[placement.pieceType] += 1;
+
+                if (next == 1) {
+                    return 1;
+                }
+                result = std::max(result, next);
+            }
+
+            // A state where no placement fits is cheap to check again, so it is not stored
+            if (result < 0 && tried) {
+                deadEnds.insert(key);
+            }
+            return result;
+        }
+    }
+
+    // Calls `callback(set)` for each set of the placements that exactly cover the empty cells, ignoring the order,
+    // and uses each piece at most `counts[piece]` times. The sets are generated one by one without being stored.
+    // Stops when `callback` returns true, and returns true if stopped
+    template<class F>
+    bool forEachPlacementSet(
+            const std::vector<std::vector<Placement>> &placements, core::Bitboard empty, std::array<int, 7> counts,
+            F &&callback
+    ) {
+        auto set = PlacementSet{};
+        auto deadEnds = pack::DeadEnds{};
+        return pack::forEachPlacementSet(placements, empty, counts, set, deadEnds, callback) == 1;
+    }
+
+    // Enumerates all sets of the placements that exactly cover the empty cells below `maxLine`, ignoring the order.
+    // The number of sets grows fast with the empty cells, so use `forEachPlacementSet` for large areas
+    std::vector<PlacementSet> findPlacementSets(const core::Factory &factory, const core::Field &field, int maxLine);
+
+    // Finds a perfect clear in two stages: the placements that fit in the field are listed once,
+    // then each queue enumerates the sets of its pieces that fill the field and checks whether one of them
+    // can be placed in some order. The reachable placements are cached by the placed cells and shared by all sets and queues,
+    // and so are the enumeration states that lead to no set
+    template<class T = core::srs::MoveGenerator>
+    class PackFinder {
+    public:
+        PackFinder<T>(const core::Factory &factory, T &moveGenerator, const core::Field &field, int maxLine)
+                : empty(getEmptyCells(field, maxLine)), placements(findPlacements(factory, field, maxLine)),
+                  cache(PlacedCellsCache<T>(factory, moveGenerator, field, maxLine)) {
+        }
+
+        // Returns the operations of the first set that can be placed in some order with the pieces, or `kNoSolution`
+        Solution run(const std::vector<core::PieceType> &pieces, bool holdEmpty);
+
+    private:
+        const core::Bitboard empty;
+        const std::vector<std::vector<Placement>> placements;
+        PlacedCellsCache<T> cache;
+
+        // Whether a state has a set to cover the cells does not depend on the queue, so they are shared by all queues
+        pack::DeadEnds deadEnds;
+    };
+
+    template<class T>
+    Solution PackFinder<T>::run(const std::vector<core::PieceType> &pieces, bool holdEmpty) {
+        int numOfCells = core::bitCount(empty);
+        if (numOfCells % 4 != 0 || static_cast<int>(pieces.size()) < numOfCells / 4) {
+            return kNoSolution;
+        }
+
+        // The pieces of the set must be in the queue, including the one held at the end
+        std::array<int, 7> counts{};
+        int usable = std::min(static_cast<int>(pieces.size()), numOfCells / 4 + 1);
+        for (int index = 0; index < usable; ++index) {
+            counts[pieces[index]] += 1;
+        }
+
+        auto solution = kNoSolution;
+        auto set = PlacementSet{};
+        auto callback = [&](const PlacementSet &found) {
+            solution = OrderFinder<T>(cache, found).run(pieces, holdEmpty);
+            return !solution.empty();
+        };
+        pack::forEachPlacementSet(placements, empty, counts, set, deadEnds, callback);
+        return solution;
+    }
+}
+
+#endif //FINDER_PACK_HPP
@@ -0,0 +1,62 @@
+#include "pareto.hpp"
+
+namespace finder {
+    namespace {
+        // Maximum attack by a T: T-Spin Triple with back-to-back
+        constexpr int MAX_ATTACK_PER_T = 7;
+    }
+
+    bool isBetterOrEqual(const Record &lhs, const Record &rhs) {
+        return rhs.tSpinAttack <= lhs.tSpinAttack
+               && lhs.softdropCount <= rhs.softdropCount
+               && lhs.lineClearCount <= rhs.lineClearCount
+               && rhs.maxCombo <= lhs.maxCombo
+               && lhs.holdCount <= rhs.holdCount;
+    }
+
+    bool ParetoArchive::add(const Record &record) {
+        for (const auto &stored : records) {
+            if (isBetterOrEqual(stored, record)) {
+                return false;
+            }
+        }
+
+        auto removed = std::remove_if(records.begin(), records.end(), [&](const Record &stored) {
+            return isBetterOrEqual(record, stored);
+        });
+        records.erase(removed, records.end());
+
+        if (static_cast<size_t>(capacity) <= records.size()) {
+            overflowed = true;
+            return false;
+        }
+
+        records.push_back(record);
+        return true;
+    }
+
+    bool ParetoArchive::isDominated(const Candidate &candidate, int leftDepth) const {
+        // Bounds of all solutions below the candidate
+        // At least one more line clear is required to finish
+        int maxTSpinAttack = candidate.tSpinAttack + candidate.leftNumOfT * MAX_ATTACK_PER_T;
+        int minLineClearCount = candidate.lineClearCount + 1;
+        int maxCombo = std::max(candidate.maxCombo, candidate.currentCombo + leftDepth);
+
+        for (const auto &stored : records) {
+            if (maxTSpinAttack <= stored.tSpinAttack
+                && stored.softdropCount <= candidate.softdropCount
+                && stored.lineClearCount <= minLineClearCount
+                && maxCombo <= stored.maxCombo
+                && stored.holdCount <= candidate.holdCount) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ParetoArchive::clear() {
+        records.clear();
+        overflowed = false;
+    }
+}
@@ -0,0 +1,263 @@
+#ifndef FINDER_PARETO_HPP
+#define FINDER_PARETO_HPP
+
+#include "perfect.hpp"
+
+namespace finder {
+    // Keeps the records that are not dominated by each other over
+    // (tSpinAttack: more, softdropCount: less, lineClearCount: less, maxCombo: more, holdCount: less).
+    // Records with the same values are stored only once.
+    class ParetoArchive {
+    public:
+        // Holds all records of the front
+        ParetoArchive() : ParetoArchive(INT_MAX) {
+        }
+
+        // Holds up to `capacity` records
+        explicit ParetoArchive(int capacity) : capacity(capacity), records(std::vector<Record>{}), overflowed(false) {
+        }
+
+        // Returns true if `record` is added to the archive.
+        // If the archive is full, a new non-dominated record is ignored unless it dominates an existing one,
+        // and the archive is marked as overflowed
+        bool add(const Record &record);
+
+        // Returns true if a non-dominated record was ignored since the last clear
+        bool isOverflowed() const {
+            return overflowed;
+        }
+
+        // Returns true if a record in the archive is better than or equal to every solution below `candidate`
+        bool isDominated(const Candidate &candidate, int leftDepth) const;
+
+        void clear();
+
+        const std::vector<Record> &get() const {
+            return records;
+        }
+
+    private:
+        const int capacity;
+        std::vector<Record> records;
+        bool overflowed;
+    };
+
+    // Returns true if `lhs` is better than or equal to `rhs` for all objectives
+    bool isBetterOrEqual(const Record &lhs, const Record &rhs);
+
+    template<class T = core::srs::MoveGenerator>
+    class ParetoFinder {
+    public:
+        // Returns all records of the front
+        ParetoFinder<T>(const core::Factory &factory, T &moveGenerator)
+                : ParetoFinder<T>(factory, moveGenerator, ParetoArchive()) {
+        }
+
+        // Returns up to `capacity` records. Check `isOverflowed` to see whether some of the front are missing
+        ParetoFinder<T>(const core::Factory &factory, T &moveGenerator, int capacity)
+                : ParetoFinder<T>(factory, moveGenerator, ParetoArchive(capacity)) {
+        }
+
+        std::vector<Record> run(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty
+        );
+
+        std::vector<Record> run(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty, int initCombo
+        );
+
+        // Returns true if the last run ignored a record of the front because the capacity was reached
+        bool isOverflowed() const {
+            return archive.isOverflowed();
+        }
+
+    private:
+        const core::Factory &factory;
+        T &moveGenerator;
+        core::srs_rotate_end::Reachable reachable;
+        ParetoArchive archive;
+
+        ParetoFinder<T>(const core::Factory &factory, T &moveGenerator, const ParetoArchive &archive)
+                : factory(factory), moveGenerator(moveGenerator), reachable(core::srs_rotate_end::Reachable(factory)),
+                  archive(archive) {
+        }
+
+        void search(const Configure &configure, const Candidate &candidate, Solution &solution);
+
+        void move(
+                const Configure &configure,
+                const Candidate &candidate,
+                Solution &solution,
+                std::vector<core::Move> &moves,
+                core::PieceType pieceType,
+                int nextIndex,
+                int nextHoldIndex,
+                int nextHoldCount
+        );
+    };
+
+    template<class T>
+    void ParetoFinder<T>::search(const Configure &configure, const Candidate &candidate, Solution &solution) {
+        if (archive.isDominated(candidate, configure.maxDepth - candidate.depth)) {
+            return;
+        }
+
+        auto &pieces = configure.pieces;
+        auto &moves = configure.movePool[candidate.depth];
+
+        auto currentIndex = candidate.currentIndex;
+        assert(0 <= currentIndex && currentIndex <= configure.pieceSize);
+        auto holdIndex = candidate.holdIndex;
+        assert(-1 <= holdIndex && holdIndex < configure.pieceSize);
+
+        auto holdCount = candidate.holdCount;
+
+        bool canUseCurrent = currentIndex < configure.pieceSize;
+        if (canUseCurrent) {
+            auto &current = pieces[currentIndex];
+
+            moves.clear();
+            move(configure, candidate, solution, moves, current, currentIndex + 1, holdIndex, holdCount);
+        }
+
+        if (0 <= holdIndex) {
+            // Hold exists
+            if (!canUseCurrent || pieces[currentIndex] != pieces[holdIndex]) {
+                auto &hold = pieces[holdIndex];
+
+                moves.clear();
+                move(configure, candidate, solution, moves, hold, currentIndex + 1, currentIndex, holdCount + 1);
+            }
+        } else {
+            assert(canUseCurrent);
+
+            // Empty hold
+            int nextIndex = currentIndex + 1;
+            if (nextIndex < configure.pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                auto &next = pieces[nextIndex];
+
+                moves.clear();
+                move(configure, candidate, solution, moves, next, nextIndex + 1, currentIndex, holdCount + 1);
+            }
+        }
+    }
+
+    template<class T>
+    void ParetoFinder<T>::move(
+            const Configure &configure,
+            const Candidate &candidate,
+            Solution &solution,
+            std::vector<core::Move> &moves,
+            core::PieceType pieceType,
+            int nextIndex,
+            int nextHoldIndex,
+            int nextHoldCount
+    ) {
+        auto depth = candidate.depth;
+        auto &field = candidate.field;
+
+        auto leftLine = candidate.leftLine;
+        assert(0 < leftLine);
+
+        auto nextLeftNumOfT = pieceType == core::PieceType::T ? candidate.leftNumOfT - 1 : candidate.leftNumOfT;
+
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        // Copied before the searches of the next depth overwrite them
+        auto positions = getReachedPositions(moveGenerator, pieceType);
+
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            auto freeze = core::Field(field);
+            freeze.put(blocks, move.x, move.y);
+
+            int numCleared = freeze.clearLineReturnNum();
+
+            solution[depth] = Operation{pieceType, move.rotateType, move.x, move.y};
+
+            int tSpinAttack = getAttackIfTSpin(
+                    reachable, positions, factory, field, pieceType, move, numCleared, candidate.b2b
+            );
+
+            int nextSoftdropCount = move.harddrop ? candidate.softdropCount : candidate.softdropCount + 1;
+            int nextLineClearCount = 0 < numCleared ? candidate.lineClearCount + 1 : candidate.lineClearCount;
+            int nextCurrentCombo = 0 < numCleared ? candidate.currentCombo + 1 : 0;
+            int nextMaxCombo = candidate.maxCombo < nextCurrentCombo ? nextCurrentCombo : candidate.maxCombo;
+            int nextTSpinAttack = candidate.tSpinAttack + tSpinAttack;
+            bool nextB2b = 0 < numCleared ? (tSpinAttack != 0 || numCleared == 4) : candidate.b2b;
+
+            int nextLeftLine = leftLine - numCleared;
+            if (nextLeftLine == 0) {
+                // Other moves can also be perfect with different counts
+                auto record = Record{
+                        Solution(solution.begin(), solution.begin() + depth + 1),
+                        nextSoftdropCount, nextHoldCount, nextLineClearCount, nextMaxCombo, nextTSpinAttack
+                };
+                archive.add(record);
+                continue;
+            }
+
+            auto nextDepth = depth + 1;
+            if (configure.maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(freeze, nextLeftLine)) {
+                continue;
+            }
+
+            auto nextCandidate = Candidate{
+                    freeze, nextIndex, nextHoldIndex, nextLeftLine, nextDepth,
+                    nextSoftdropCount, nextHoldCount, nextLineClearCount, nextCurrentCombo, nextMaxCombo,
+                    nextTSpinAttack, nextB2b, nextLeftNumOfT,
+            };
+            search(configure, nextCandidate, solution);
+        }
+    }
+
+    template<class T>
+    std::vector<Record> ParetoFinder<T>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty, int initCombo
+    ) {
+        assert(1 <= maxDepth);
+
+        auto freeze = core::Field(field);
+
+        std::vector<std::vector<core::Move>> movePool(maxDepth);
+
+        Solution solution(maxDepth);
+
+        const Configure configure{
+                pieces,
+                movePool,
+                maxDepth,
+                static_cast<int>(pieces.size()),
+        };
+
+        int leftNumOfT = static_cast<int>(std::count(pieces.begin(), pieces.end(), core::PieceType::T));
+
+        Candidate candidate = holdEmpty
+                              ? Candidate{freeze, 0, -1, maxLine, 0, 0, 0, 0, initCombo, initCombo, 0, true, leftNumOfT}
+                              : Candidate{freeze, 1, 0, maxLine, 0, 0, 0, 0, initCombo, initCombo, 0, true, leftNumOfT};
+
+        archive.clear();
+
+        search(configure, candidate, solution);
+
+        return archive.get();
+    }
+
+    template<class T>
+    std::vector<Record> ParetoFinder<T>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        return run(field, pieces, maxDepth, maxLine, holdEmpty, 0);
+    }
+}
+
+#endif //FINDER_PARETO_HPP
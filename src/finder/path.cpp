@@ -0,0 +1,27 @@
+#include "path.hpp"
+
+namespace finder {
+    std::vector<std::vector<core::Inputs>> toInputs(
+            const core::Factory &factory, const core::Field &field, const Solution &solution, int maxLine
+    ) {
+        auto freeze = core::Field(field);
+        int leftLine = maxLine;
+
+        auto result = std::vector<std::vector<core::Inputs>>(solution.size());
+        for (size_t index = 0; index < solution.size(); ++index) {
+            auto &operation = solution[index];
+
+            if (0 < leftLine) {
+                core::findInputs(
+                        result[index], factory, freeze,
+                        operation.pieceType, operation.rotateType, operation.x, operation.y, leftLine
+                );
+            }
+
+            freeze.put(factory.get(operation.pieceType, operation.rotateType), operation.x, operation.y);
+            leftLine -= freeze.clearLineReturnNum();
+        }
+
+        return result;
+    }
+}
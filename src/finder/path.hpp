@@ -0,0 +1,16 @@
+#ifndef FINDER_PATH_HPP
+#define FINDER_PATH_HPP
+
+#include "perfect.hpp"
+#include "../core/path.hpp"
+
+namespace finder {
+    // The inputs of each operation in order, on the field after the previous operations and their line clears.
+    // The piece appears at the top of the lines left, as in the finders.
+    // The inputs of an operation are empty if it cannot be reached
+    std::vector<std::vector<core::Inputs>> toInputs(
+            const core::Factory &factory, const core::Field &field, const Solution &solution, int maxLine
+    );
+}
+
+#endif //FINDER_PATH_HPP
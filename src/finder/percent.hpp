@@ -0,0 +1,335 @@
+#ifndef FINDER_PERCENT_HPP
+#define FINDER_PERCENT_HPP
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <thread>
+
+#include "mirror.hpp"
+#include "perfect.hpp"
+#include "sequence_set.hpp"
+#include "sequence_space.hpp"
+
+namespace finder {
+    struct PercentResult {
+        int success;
+        int total;
+        std::array<int, 7> successByFirst;  // Indexed by the first piece of the sequence
+        std::array<int, 7> totalByFirst;
+        SequenceSet successes;  // Indexed in the order of the input sequences
+
+        double rate() const {
+            return total == 0 ? 0.0 : static_cast<double>(success) / total;
+        }
+    };
+
+    // Computes the rate of sequences that can be a perfect clear. All sequences must have the same length.
+    // Sequences that share a prefix are searched together: the tree branches on a piece only when it is needed,
+    // and a sequence is no longer searched once a solution is found for it.
+    // If the field is left-right symmetric, a sequence and its mirrored sequence share the result,
+    // so only one of them is searched when the kicks of their pieces are symmetric too
+    template<class T = core::srs::MoveGenerator>
+    class PercentFinder {
+    public:
+        // Uses all hardware threads if `numOfThreads` is 0
+        PercentFinder<T>(const core::Factory &factory, int numOfThreads)
+                : factory(factory), numOfThreads(0 < numOfThreads ? numOfThreads : defaultNumOfThreads()) {
+        }
+
+        explicit PercentFinder<T>(const core::Factory &factory) : PercentFinder<T>(factory, 0) {
+        }
+
+        PercentResult run(
+                const core::Field &field, const std::vector<Sequence> &sequences,
+                int maxDepth, int maxLine, bool holdEmpty
+        );
+
+        // The result is indexed by the rank in the space
+        PercentResult run(
+                const core::Field &field, const SequenceSpace &space, int maxDepth, int maxLine, bool holdEmpty
+        ) {
+            auto sequences = std::vector<Sequence>{};
+            sequences.reserve(space.size());
+            space.forEach([&](int64_t, const Sequence &sequence) {
+                sequences.push_back(sequence);
+            });
+            return run(field, sequences, maxDepth, maxLine, holdEmpty);
+        }
+
+    private:
+        const core::Factory &factory;
+        const int numOfThreads;
+
+        static int defaultNumOfThreads() {
+            int concurrency = static_cast<int>(std::thread::hardware_concurrency());
+            return 0 < concurrency ? concurrency : 1;
+        }
+
+        // Returns the index of the sequence that is searched instead of each sequence
+        std::vector<int> getRepresentatives(const core::Field &field, const std::vector<Sequence> &sequences) const;
+
+        struct Worker {
+            const core::Factory &factory;
+            const std::vector<Sequence> &sequences;
+            std::vector<char> &successes;
+            const int maxDepth;
+            T moveGenerator;
+            std::vector<std::vector<core::Move>> movePool;
+
+            // `pending` contains the sequences that have the same pieces before `currentIndex`
+            void search(
+                    const core::Field &field, int currentIndex, int holdIndex, int leftLine, int depth,
+                    std::vector<int> &pending
+            );
+
+            void move(
+                    const core::Field &field, int leftLine, int depth, core::PieceType pieceType,
+                    int nextIndex, int nextHoldIndex, std::vector<int> &pending
+            );
+
+            void removeSucceeded(std::vector<int> &pending) const {
+                pending.erase(std::remove_if(pending.begin(), pending.end(), [&](int index) {
+                    return successes[index] != 0;
+                }), pending.end());
+            }
+
+            // Calls `callback(piece, group)` for each group of the sequences that have the same piece at `index`
+            template<class F>
+            void forEachGroup(const std::vector<int> &pending, int index, F &&callback) {
+                auto begin = pending.begin();
+                while (begin != pending.end()) {
+                    auto piece = sequences[*begin][index];
+                    auto end = std::find_if(begin, pending.end(), [&](int sequence) {
+                        return sequences[sequence][index] != piece;
+                    });
+                    auto group = std::vector<int>(begin, end);
+                    callback(piece, group);
+                    begin = end;
+                }
+            }
+        };
+    };
+
+    template<class T>
+    void PercentFinder<T>::Worker::search(
+            const core::Field &field, int currentIndex, int holdIndex, int leftLine, int depth,
+            std::vector<int> &pending
+    ) {
+        assert(!pending.empty());
+
+        int pieceSize = static_cast<int>(sequences[pending[0]].size());
+
+        if (pieceSize <= currentIndex) {
+            // Hold only
+            assert(0 <= holdIndex);
+            auto hold = sequences[pending[0]][holdIndex];
+            move(field, leftLine, depth, hold, currentIndex + 1, currentIndex, pending);
+            return;
+        }
+
+        forEachGroup(pending, currentIndex, [&](core::PieceType current, std::vector<int> &group) {
+            move(field, leftLine, depth, current, currentIndex + 1, holdIndex, group);
+            removeSucceeded(group);
+            if (group.empty()) {
+                return;
+            }
+
+            if (0 <= holdIndex) {
+                // Hold exists
+                auto hold = sequences[group[0]][holdIndex];
+                if (current != hold) {
+                    move(field, leftLine, depth, hold, currentIndex + 1, currentIndex, group);
+                }
+            } else {
+                // Empty hold
+                int nextIndex = currentIndex + 1;
+                if (nextIndex < pieceSize) {
+                    forEachGroup(group, nextIndex, [&](core::PieceType next, std::vector<int> &nextGroup) {
+                        if (current != next) {
+                            move(field, leftLine, depth, next, nextIndex + 1, currentIndex, nextGroup);
+                        }
+                    });
+                }
+            }
+        });
+    }
+
+    template<class T>
+    void PercentFinder<T>::Worker::move(
+            const core::Field &field, int leftLine, int depth, core::PieceType pieceType,
+            int nextIndex, int nextHoldIndex, std::vector<int> &pending
+    ) {
+        assert(0 < leftLine);
+
+        auto &moves = movePool[depth];
+        moves.clear();
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            auto freeze = core::Field(field);
+            freeze.put(blocks, move.x, move.y);
+
+            int numCleared = freeze.clearLineReturnNum();
+
+            int nextLeftLine = leftLine - numCleared;
+            if (nextLeftLine == 0) {
+                for (int index : pending) {
+                    successes[index] = 1;
+                }
+                pending.clear();
+                return;
+            }
+
+            auto nextDepth = depth + 1;
+            if (maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(freeze, nextLeftLine)) {
+                continue;
+            }
+
+            auto next = std::vector<int>(pending);
+            search(freeze, nextIndex, nextHoldIndex, nextLeftLine, nextDepth, next);
+
+            removeSucceeded(pending);
+            if (pending.empty()) {
+                return;
+            }
+        }
+    }
+
+    template<class T>
+    std::vector<int> PercentFinder<T>::getRepresentatives(
+            const core::Field &field, const std::vector<Sequence> &sequences
+    ) const {
+        int size = static_cast<int>(sequences.size());
+        std::vector<int> representatives(size);
+        for (int index = 0; index < size; ++index) {
+            representatives[index] = index;
+        }
+
+        auto mirrorField = core::Field(field);
+        mirrorField.mirror();
+        if (mirrorField != field) {
+            return representatives;
+        }
+
+        std::array<bool, 7> symmetric{};
+        for (int piece = 0; piece < 7; ++piece) {
+            symmetric[piece] = isMirrorSymmetric(factory, static_cast<core::PieceType>(piece));
+        }
+
+        std::map<Sequence, int> indexes{};
+        for (int index = 0; index < size; ++index) {
+            indexes.emplace(sequences[index], index);
+        }
+
+        for (int index = 0; index < size; ++index) {
+            auto &sequence = sequences[index];
+            if (!std::all_of(sequence.begin(), sequence.end(), [&](core::PieceType piece) {
+                return symmetric[piece];
+            })) {
+                continue;
+            }
+
+            // The smaller one of the pair is searched
+            auto mirrorSequence = mirror(sequence);
+            if (mirrorSequence < sequence) {
+                auto it = indexes.find(mirrorSequence);
+                if (it != indexes.end()) {
+                    representatives[index] = it->second;
+                }
+            }
+        }
+
+        return representatives;
+    }
+
+    template<class T>
+    PercentResult PercentFinder<T>::run(
+            const core::Field &field, const std::vector<Sequence> &sequences,
+            int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        assert(1 <= maxDepth);
+
+        int size = static_cast<int>(sequences.size());
+        assert(std::all_of(sequences.begin(), sequences.end(), [&](const Sequence &sequence) {
+            return !sequence.empty() && sequence.size() == sequences[0].size();
+        }));
+
+        auto representatives = getRepresentatives(field, sequences);
+
+        // Sort to put sequences with the same prefix side by side
+        std::vector<int> sorted{};
+        for (int index = 0; index < size; ++index) {
+            if (representatives[index] == index) {
+                sorted.push_back(index);
+            }
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [&](int lhs, int rhs) {
+            return sequences[lhs] < sequences[rhs];
+        });
+
+        // Tasks by the first two pieces
+        std::vector<std::vector<int>> tasks{};
+        for (int index : sorted) {
+            auto &sequence = sequences[index];
+            if (!tasks.empty()) {
+                auto &last = sequences[tasks.back()[0]];
+                if (last[0] == sequence[0] && (sequence.size() < 2 || last[1] == sequence[1])) {
+                    tasks.back().push_back(index);
+                    continue;
+                }
+            }
+            tasks.push_back(std::vector<int>{index});
+        }
+
+        std::vector<char> successes(size, 0);
+        std::atomic<int> nextTask(0);
+
+        auto execute = [&]() {
+            auto worker = Worker{
+                    factory, sequences, successes, maxDepth, T(factory),
+                    std::vector<std::vector<core::Move>>(maxDepth),
+            };
+
+            for (int task = nextTask++; task < static_cast<int>(tasks.size()); task = nextTask++) {
+                auto pending = std::vector<int>(tasks[task]);
+                if (holdEmpty) {
+                    worker.search(field, 0, -1, maxLine, 0, pending);
+                } else {
+                    worker.search(field, 1, 0, maxLine, 0, pending);
+                }
+            }
+        };
+
+        int numOfWorkers = std::min(numOfThreads, static_cast<int>(tasks.size()));
+        std::vector<std::thread> threads{};
+        for (int index = 1; index < numOfWorkers; ++index) {
+            threads.emplace_back(execute);
+        }
+        execute();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        auto result = PercentResult{0, size, {}, {}, SequenceSet(size)};
+        for (int index = 0; index < size; ++index) {
+            auto first = sequences[index][0];
+            result.totalByFirst[first] += 1;
+            if (successes[representatives[index]] != 0) {
+                result.success += 1;
+                result.successByFirst[first] += 1;
+                result.successes.set(index);
+            }
+        }
+
+        return result;
+    }
+}
+
+#endif //FINDER_PERCENT_HPP
@@ -1,6 +1,12 @@
 #ifndef CORE_PERFECT_HPP
 #define CORE_PERFECT_HPP
 
+#include <climits>
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
 #include "../core/piece.hpp"
 #include "../core/moves.hpp"
 #include "../core/types.hpp"
@@ -38,7 +44,6 @@ namespace finder {
         std::vector<std::vector<core::Move>> &movePool;
         const int maxDepth;
         const int pieceSize;
-        const bool leastLineClears;
     };
 
     struct Operation {
@@ -60,6 +65,27 @@ namespace finder {
         int tSpinAttack;
     };
 
+    // A search state. In a run, the number of used pieces and the remaining lines are determined by
+    // the field and the indexes
+    struct StateKey {
+        core::Field field;
+        int currentIndex;
+        int holdIndex;
+    };
+
+    inline bool operator==(const StateKey &lhs, const StateKey &rhs) {
+        return lhs.currentIndex == rhs.currentIndex && lhs.holdIndex == rhs.holdIndex && lhs.field == rhs.field;
+    }
+
+    struct StateKeyHasher {
+        size_t operator()(const StateKey &key) const noexcept {
+            auto hash = std::hash<core::Field>{}(key.field);
+            return hash ^ (static_cast<size_t>(key.currentIndex) << 8 | static_cast<size_t>(key.holdIndex + 1)) * 31;
+        }
+    };
+
+    bool validate(const core::Field &field, int maxLine);
+
     TSpinShapes getTSpinShape(const core::Field &field, int x, int y, core::RotateType rotateType);
 
     int getAttackIfTSpin(
@@ -67,18 +93,141 @@ namespace finder {
             core::PieceType pieceType, const core::Move &move, int numCleared, bool b2b
     );
 
-    template<class T = core::srs::MoveGenerator>
+    // Same as above, but the rotation is looked up in the positions of the search that generated the move
+    int getAttackIfTSpin(
+            core::srs_rotate_end::Reachable &reachable, const core::srs_iterative::ReachedPositions &positions,
+            const core::Factory &factory, const core::Field &field,
+            core::PieceType pieceType, const core::Move &move, int numCleared, bool b2b
+    );
+
+    // Same as above, but the rotation is taken from `Move::lastAction`, which must be classified
+    int getAttackIfTSpin(
+            const core::Field &field, core::PieceType pieceType, const core::Move &move, int numCleared, bool b2b
+    );
+
+    // Takes the rotation from the move or the positions of the search if either has it, and searches otherwise
+    int getAttackIfTSpin(
+            core::srs_rotate_end::Reachable &reachable,
+            const std::optional<core::srs_iterative::ReachedPositions> &positions,
+            const core::Factory &factory, const core::Field &field,
+            core::PieceType pieceType, const core::Move &move, int numCleared, bool b2b
+    );
+
+    // The generators that keep the positions of a search return them for T, which are used for T-Spins
+    template<class T>
+    std::optional<core::srs_iterative::ReachedPositions> getReachedPositions(const T &, core::PieceType) {
+        return std::nullopt;
+    }
+
+    inline std::optional<core::srs_iterative::ReachedPositions> getReachedPositions(
+            const core::srs_iterative::MoveGenerator &moveGenerator, core::PieceType pieceType
+    ) {
+        if (pieceType != core::PieceType::T) {
+            return std::nullopt;
+        }
+        return moveGenerator.getReachedPositions();
+    }
+
+    // A priority is a policy that defines the order of solutions. Any type with the following static functions
+    // can be passed to `PerfectFinder`:
+    //   static bool shouldUpdate(const Record &oldRecord, const Record &newRecord);
+    //     Returns true if `newRecord` should replace the current best `oldRecord`
+    //   static bool isWorseThanBest(const Record &best, const Candidate &current);
+    //     Returns true if no descendant of `current` can be better than `best` (the subtree is pruned)
+    template<PriorityTypes T>
+    struct Priority;
+
+    template<>
+    struct Priority<PriorityTypes::LeastSoftdrop_LeastLineClear_LeastHold> {
+        static bool shouldUpdate(const Record &oldRecord, const Record &newRecord) {
+            if (newRecord.tSpinAttack != oldRecord.tSpinAttack) {
+                return oldRecord.tSpinAttack < newRecord.tSpinAttack;
+            }
+
+            if (newRecord.softdropCount != oldRecord.softdropCount) {
+                return newRecord.softdropCount < oldRecord.softdropCount;
+            }
+
+            if (newRecord.lineClearCount != oldRecord.lineClearCount) {
+                return newRecord.lineClearCount < oldRecord.lineClearCount;
+            }
+
+            return newRecord.holdCount < oldRecord.holdCount;
+        }
+
+        static bool isWorseThanBest(const Record &best, const Candidate &current) {
+            if (current.leftNumOfT == 0) {
+                if (current.tSpinAttack != best.tSpinAttack) {
+                    return current.tSpinAttack < best.tSpinAttack;
+                }
+
+                // return best.softdropCount < current.softdropCount || INT_MAX < current.lineClearCount;
+                return best.softdropCount < current.softdropCount;
+            }
+
+            return false;
+        }
+    };
+
+    template<>
+    struct Priority<PriorityTypes::LeastSoftdrop_MostCombo_MostLineClear_LeastHold> {
+        static bool shouldUpdate(const Record &oldRecord, const Record &newRecord) {
+            if (newRecord.tSpinAttack != oldRecord.tSpinAttack) {
+                return oldRecord.tSpinAttack < newRecord.tSpinAttack;
+            }
+
+            if (newRecord.softdropCount != oldRecord.softdropCount) {
+                return newRecord.softdropCount < oldRecord.softdropCount;
+            }
+
+            if (newRecord.maxCombo != oldRecord.maxCombo) {
+                return oldRecord.maxCombo < newRecord.maxCombo;
+            }
+
+            if (newRecord.lineClearCount != oldRecord.lineClearCount) {
+                return oldRecord.lineClearCount < newRecord.lineClearCount;
+            }
+
+            return newRecord.holdCount < oldRecord.holdCount;
+        }
+
+        static bool isWorseThanBest(const Record &best, const Candidate &current) {
+            if (current.leftNumOfT == 0) {
+                if (current.tSpinAttack != best.tSpinAttack) {
+                    return current.tSpinAttack < best.tSpinAttack;
+                }
+
+                return best.softdropCount < current.softdropCount;
+            }
+
+            return false;
+        }
+    };
+
+    using LeastLineClearPriority = Priority<PriorityTypes::LeastSoftdrop_LeastLineClear_LeastHold>;
+    using MostComboPriority = Priority<PriorityTypes::LeastSoftdrop_MostCombo_MostLineClear_LeastHold>;
+
+    template<class T = core::srs::MoveGenerator, class P = LeastLineClearPriority>
     class PerfectFinder {
     public:
-        PerfectFinder<T>(const core::Factory &factory, T &moveGenerator)
+        PerfectFinder<T, P>(const core::Factory &factory, T &moveGenerator)
                 : factory(factory), moveGenerator(moveGenerator), reachable(core::srs_rotate_end::Reachable(factory)) {
         }
 
+        // Search with the priority `P`
         Solution run(
                 const core::Field &field, const std::vector<core::PieceType> &pieces,
                 int maxDepth, int maxLine, bool holdEmpty
         );
 
+        // Search with the priority `P`, starting from the combo
+        Solution runWithInitCombo(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty, int initCombo
+        );
+
+        // Search with one of the built-in priorities, selected once per run.
+        // Only for the default priority, so that it does not silently replace a custom `P`
         Solution run(
                 const core::Field &field, const std::vector<core::PieceType> &pieces,
                 int maxDepth, int maxLine, bool holdEmpty, bool leastLineClears, int initCombo
@@ -90,8 +239,16 @@ namespace finder {
         core::srs_rotate_end::Reachable reachable;
         Record best;
 
+        template<class Order>
+        Solution run_(
+                const core::Field &field, const std::vector<core::PieceType> &pieces,
+                int maxDepth, int maxLine, bool holdEmpty, int initCombo
+        );
+
+        template<class Order>
         void search(const Configure &configure, const Candidate &candidate, Solution &solution);
 
+        template<class Order>
         void move(
                 const Configure &configure,
                 const Candidate &candidate,
@@ -103,8 +260,251 @@ namespace finder {
                 int nextHoldCount
         );
 
-        void accept(const Configure &configure, const Record &record);
+        template<class Order>
+        void accept(const Record &record);
     };
+
+    template<class T, class P>
+    template<class Order>
+    void PerfectFinder<T, P>::search(
+            const Configure &configure,
+            const Candidate &candidate,
+            Solution &solution
+    ) {
+        if (Order::isWorseThanBest(best, candidate)) {
+            return;
+        }
+
+        auto depth = candidate.depth;
+
+        auto &pieces = configure.pieces;
+        auto &moves = configure.movePool[depth];
+
+        auto currentIndex = candidate.currentIndex;
+        assert(0 <= currentIndex && currentIndex <= configure.pieceSize);
+        auto holdIndex = candidate.holdIndex;
+        assert(-1 <= holdIndex && holdIndex < configure.pieceSize);
+
+        auto holdCount = candidate.holdCount;
+
+        bool canUseCurrent = currentIndex < configure.pieceSize;
+        if (canUseCurrent) {
+            assert(currentIndex < configure.pieceSize);
+            auto &current = pieces[currentIndex];
+
+            moves.clear();
+            move<Order>(configure, candidate, solution, moves, current, currentIndex + 1, holdIndex, holdCount);
+        }
+
+        if (0 <= holdIndex) {
+            assert(holdIndex < configure.pieceSize);
+
+            // Hold exists
+            if (!canUseCurrent || pieces[currentIndex] != pieces[holdIndex]) {
+                auto &hold = pieces[holdIndex];
+
+                moves.clear();
+                move<Order>(configure, candidate, solution, moves, hold, currentIndex + 1, currentIndex, holdCount + 1);
+            }
+        } else {
+            assert(canUseCurrent);
+
+            // Empty hold
+            int nextIndex = currentIndex + 1;
+            assert(nextIndex <= configure.pieceSize);
+
+            if (nextIndex < configure.pieceSize && pieces[currentIndex] != pieces[nextIndex]) {
+                assert(nextIndex < configure.pieceSize);
+                auto &next = pieces[nextIndex];
+
+                moves.clear();
+                move<Order>(configure, candidate, solution, moves, next, nextIndex + 1, currentIndex, holdCount + 1);
+            }
+        }
+    }
+
+    template<class T, class P>
+    template<class Order>
+    void PerfectFinder<T, P>::accept(const Record &record) {
+        assert(!best.solution.empty());
+
+        if (best.solution[0].x == -1 || Order::shouldUpdate(best, record)) {
+            best = Record(record);
+        }
+    }
+
+    template<class T, class P>
+    template<class Order>
+    void PerfectFinder<T, P>::move(
+            const Configure &configure,
+            const Candidate &candidate,
+            Solution &solution,
+            std::vector<core::Move> &moves,
+            core::PieceType pieceType,
+            int nextIndex,
+            int nextHoldIndex,
+            int nextHoldCount
+    ) {
+        auto depth = candidate.depth;
+        auto maxDepth = configure.maxDepth;
+        auto &field = candidate.field;
+
+        auto leftLine = candidate.leftLine;
+        assert(0 < leftLine);
+
+        auto softdropCount = candidate.softdropCount;
+        auto lineClearCount = candidate.lineClearCount;
+
+        auto currentCombo = candidate.currentCombo;
+        auto maxCombo = candidate.maxCombo;
+
+        auto currentTSpinAttack = candidate.tSpinAttack;
+        auto currentB2b = candidate.b2b;
+
+        auto nextLeftNumOfT = pieceType == core::PieceType::T ? candidate.leftNumOfT - 1 : candidate.leftNumOfT;
+
+        moveGenerator.search(moves, field, pieceType, leftLine);
+
+        // Copied before the searches of the next depth overwrite them
+        auto positions = getReachedPositions(moveGenerator, pieceType);
+
+        for (const auto &move : moves) {
+            auto &blocks = factory.get(pieceType, move.rotateType);
+
+            auto freeze = core::Field(field);
+            freeze.put(blocks, move.x, move.y);
+
+            int numCleared = freeze.clearLineReturnNum();
+
+            solution[depth].pieceType = pieceType;
+            solution[depth].rotateType = move.rotateType;
+            solution[depth].x = move.x;
+            solution[depth].y = move.y;
+
+            int tSpinAttack = getAttackIfTSpin(
+                    reachable, positions, factory, field, pieceType, move, numCleared, currentB2b
+            );
+
+            int nextSoftdropCount = move.harddrop ? softdropCount : softdropCount + 1;
+            int nextLineClearCount = 0 < numCleared ? lineClearCount + 1 : lineClearCount;
+            int nextCurrentCombo = 0 < numCleared ? currentCombo + 1 : 0;
+            int nextMaxCombo = maxCombo < nextCurrentCombo ? nextCurrentCombo : maxCombo;
+            int nextTSpinAttack = currentTSpinAttack + tSpinAttack;
+            bool nextB2b = 0 < numCleared ? (tSpinAttack != 0 || numCleared == 4) : currentB2b;
+
+            int nextLeftLine = leftLine - numCleared;
+            if (nextLeftLine == 0) {
+                auto record = Record{
+                        solution, nextSoftdropCount, nextHoldCount, nextLineClearCount, nextMaxCombo, nextTSpinAttack
+                };
+                accept<Order>(record);
+                return;
+            }
+
+            auto nextDepth = depth + 1;
+            if (maxDepth <= nextDepth) {
+                continue;
+            }
+
+            if (!validate(freeze, nextLeftLine)) {
+                continue;
+            }
+
+            auto nextCandidate = Candidate{
+                    freeze, nextIndex, nextHoldIndex, nextLeftLine, nextDepth,
+                    nextSoftdropCount, nextHoldCount, nextLineClearCount, nextCurrentCombo, nextMaxCombo,
+                    nextTSpinAttack, nextB2b, nextLeftNumOfT,
+            };
+            search<Order>(configure, nextCandidate, solution);
+        }
+    }
+
+    template<class T, class P>
+    template<class Order>
+    Solution PerfectFinder<T, P>::run_(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty, int initCombo
+    ) {
+        assert(1 <= maxDepth);
+
+        // Copy field
+        auto freeze = core::Field(field);
+
+        // Initialize moves
+        std::vector<std::vector<core::Move>> movePool(maxDepth);
+        for (int index = 0; index < maxDepth; ++index) {
+            movePool[index] = std::vector<core::Move>{};
+        }
+
+        // Initialize solution
+        Solution solution(maxDepth);
+        for (int index = 0; index < maxDepth; ++index) {
+            solution[index] = Operation{
+                    core::PieceType::T, core::RotateType::Spawn, -1, -1
+            };
+        }
+
+        // Initialize configure
+        const Configure configure{
+                pieces,
+                movePool,
+                maxDepth,
+                static_cast<int>(pieces.size()),
+        };
+
+        // Count up T
+        int leftNumOfT = static_cast<int>(std::count(pieces.begin(), pieces.end(), core::PieceType::T));
+
+        // Create candidate
+        Candidate candidate = holdEmpty
+                              ? Candidate{freeze, 0, -1, maxLine, 0, 0, 0, 0, initCombo, initCombo, 0, true, leftNumOfT}
+                              : Candidate{freeze, 1, 0, maxLine, 0, 0, 0, 0, initCombo, initCombo, 0, true, leftNumOfT};
+
+        // Create current record & best record
+        best = Record{
+                std::vector(solution),
+                INT_MAX,
+                INT_MAX,
+                INT_MAX,
+                0,
+        };
+
+        // Execute
+        search<Order>(configure, candidate, solution);
+
+        return best.solution[0].x == -1 ? kNoSolution : std::vector<Operation>(best.solution);
+    }
+
+    template<class T, class P>
+    Solution PerfectFinder<T, P>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty, bool leastLineClears, int initCombo
+    ) {
+        static_assert(std::is_same<P, LeastLineClearPriority>::value,
+                      "Use runWithInitCombo to search with a custom priority");
+
+        if (leastLineClears) {
+            return run_<LeastLineClearPriority>(field, pieces, maxDepth, maxLine, holdEmpty, initCombo);
+        } else {
+            return run_<MostComboPriority>(field, pieces, maxDepth, maxLine, holdEmpty, initCombo);
+        }
+    }
+
+    template<class T, class P>
+    Solution PerfectFinder<T, P>::runWithInitCombo(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty, int initCombo
+    ) {
+        return run_<P>(field, pieces, maxDepth, maxLine, holdEmpty, initCombo);
+    }
+
+    template<class T, class P>
+    Solution PerfectFinder<T, P>::run(
+            const core::Field &field, const std::vector<core::PieceType> &pieces,
+            int maxDepth, int maxLine, bool holdEmpty
+    ) {
+        return run_<P>(field, pieces, maxDepth, maxLine, holdEmpty, 0);
+    }
 }
 
 #endif //CORE_PERFECT_HPP
@@ -0,0 +1,50 @@
+#include "sequence_set.hpp"
+
+#include "../core/bits.hpp"
+
+namespace finder {
+    int SequenceSet::count() const {
+        uint64_t count = 0;
+        for (auto word : words) {
+            count += core::bitCount(word);
+        }
+        return static_cast<int>(count);
+    }
+
+    int SequenceSet::countAnd(const SequenceSet &other) const {
+        assert(numOfSequences == other.numOfSequences);
+        uint64_t count = 0;
+        for (size_t index = 0; index < words.size(); ++index) {
+            count += core::bitCount(words[index] & other.words[index]);
+        }
+        return static_cast<int>(count);
+    }
+
+    SequenceSet &SequenceSet::operator&=(const SequenceSet &other) {
+        assert(numOfSequences == other.numOfSequences);
+        for (size_t index = 0; index < words.size(); ++index) {
+            words[index] &= other.words[index];
+        }
+        return *this;
+    }
+
+    SequenceSet &SequenceSet::operator|=(const SequenceSet &other) {
+        assert(numOfSequences == other.numOfSequences);
+        for (size_t index = 0; index < words.size(); ++index) {
+            words[index] |= other.words[index];
+        }
+        return *this;
+    }
+
+    SequenceSet operator&(const SequenceSet &lhs, const SequenceSet &rhs) {
+        auto set = SequenceSet(lhs);
+        set &= rhs;
+        return set;
+    }
+
+    SequenceSet operator|(const SequenceSet &lhs, const SequenceSet &rhs) {
+        auto set = SequenceSet(lhs);
+        set |= rhs;
+        return set;
+    }
+}
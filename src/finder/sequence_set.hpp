@@ -0,0 +1,65 @@
+#ifndef FINDER_SEQUENCE_SET_HPP
+#define FINDER_SEQUENCE_SET_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace finder {
+    // Set of sequence indexes in a `SequenceSpace`. Each result over the 5040 orders of 7 pieces fits in 79 words
+    class SequenceSet {
+    public:
+        explicit SequenceSet(int size) : numOfSequences(size), words(std::vector<uint64_t>((size + 63) / 64)) {
+        }
+
+        SequenceSet() : SequenceSet(0) {
+        }
+
+        int size() const {
+            return numOfSequences;
+        }
+
+        bool test(int index) const {
+            assert(0 <= index && index < numOfSequences);
+            return (words[index >> 6] & (1ULL << (index & 63))) != 0;
+        }
+
+        void set(int index) {
+            assert(0 <= index && index < numOfSequences);
+            words[index >> 6] |= 1ULL << (index & 63);
+        }
+
+        void reset(int index) {
+            assert(0 <= index && index < numOfSequences);
+            words[index >> 6] &= ~(1ULL << (index & 63));
+        }
+
+        int count() const;
+
+        // The number of indexes in both sets, without building the intersection
+        int countAnd(const SequenceSet &other) const;
+
+        SequenceSet &operator&=(const SequenceSet &other);
+
+        SequenceSet &operator|=(const SequenceSet &other);
+
+        bool operator==(const SequenceSet &other) const {
+            return numOfSequences == other.numOfSequences && words == other.words;
+        }
+
+        bool operator!=(const SequenceSet &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        int numOfSequences;
+        std::vector<uint64_t> words;
+    };
+
+    SequenceSet operator&(const SequenceSet &lhs, const SequenceSet &rhs);
+
+    SequenceSet operator|(const SequenceSet &lhs, const SequenceSet &rhs);
+}
+
+#endif //FINDER_SEQUENCE_SET_HPP
@@ -0,0 +1,171 @@
+#include "sequence_space.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace finder {
+    namespace {
+        constexpr int kAllPieceBit = 0b1111111;
+
+        // The index of the `n`th set bit of 7 bits
+        constexpr std::array<std::array<int8_t, 7>, 128> createSelectTable() {
+            std::array<std::array<int8_t, 7>, 128> table{};
+            for (int bit = 0; bit < 128; ++bit) {
+                int n = 0;
+                for (int index = 0; index < 7; ++index) {
+                    if ((bit & (1 << index)) != 0) {
+                        table[bit][n] = static_cast<int8_t>(index);
+                        n += 1;
+                    }
+                }
+            }
+            return table;
+        }
+
+        constexpr auto kSelectTable = createSelectTable();
+
+        int bitCount7(int bit) {
+            bit = (bit & 0x55) + ((bit >> 1) & 0x55);
+            bit = (bit & 0x33) + ((bit >> 2) & 0x33);
+            return (bit & 0x0f) + (bit >> 4);
+        }
+    }
+
+    SequenceSpace::SequenceSpace(const Sequence &prefix, int length, int firstBagBit, bool isBag)
+            : prefix(prefix), firstBagBit(firstBagBit), isBag(isBag) {
+        assert(static_cast<int>(prefix.size()) <= length);
+        assert(0 < firstBagBit && firstBagBit <= kAllPieceBit);
+
+        int left = bitCount7(firstBagBit);
+        numOfSequences = 1;
+        for (int position = static_cast<int>(prefix.size()); position < length; ++position) {
+            int radix = isBag ? left : 7;
+            radixes.push_back(radix);
+
+            assert(numOfSequences <= INT64_MAX / radix);
+            numOfSequences *= radix;
+
+            left = left == 1 ? 7 : left - 1;
+        }
+    }
+
+    SequenceSpace SequenceSpace::createPermutations(int length) {
+        assert(0 <= length && length <= 7);
+        return SequenceSpace(Sequence{}, length, kAllPieceBit, true);
+    }
+
+    SequenceSpace SequenceSpace::createBag(const Sequence &prefix, int length, int firstBagBit) {
+        return SequenceSpace(prefix, length, firstBagBit, true);
+    }
+
+    SequenceSpace SequenceSpace::createBag(const Sequence &prefix, int length) {
+        return SequenceSpace(prefix, length, kAllPieceBit, true);
+    }
+
+    SequenceSpace SequenceSpace::createRepetition(const Sequence &prefix, int length) {
+        return SequenceSpace(prefix, length, kAllPieceBit, false);
+    }
+
+    int SequenceSpace::getAvailableBit(const Sequence &sequence, int position) const {
+        if (!isBag) {
+            return kAllPieceBit;
+        }
+
+        // Replay the current bag from the last refill
+        int start = static_cast<int>(prefix.size());
+        int offset = position - start;
+        int firstSize = bitCount7(firstBagBit);
+        int bit;
+        int bagStart;
+        if (offset < firstSize) {
+            bit = firstBagBit;
+            bagStart = start;
+        } else {
+            bit = kAllPieceBit;
+            bagStart = start + firstSize + (offset - firstSize) / 7 * 7;
+        }
+
+        for (int index = bagStart; index < position; ++index) {
+            bit &= ~(1 << sequence[index]);
+        }
+        return bit;
+    }
+
+    void SequenceSpace::fill(Sequence &sequence, const std::vector<int> &digits, int start) const {
+        int offset = static_cast<int>(prefix.size());
+        int numOfDigits = static_cast<int>(radixes.size());
+
+        int bit = getAvailableBit(sequence, offset + start);
+        for (int position = start; position < numOfDigits; ++position) {
+            if (bit == 0) {
+                bit = kAllPieceBit;
+            }
+
+            int piece = kSelectTable[bit][digits[position]];
+            sequence[offset + position] = static_cast<core::PieceType>(piece);
+
+            if (isBag) {
+                bit &= ~(1 << piece);
+            }
+        }
+    }
+
+    int64_t SequenceSpace::rank(const Sequence &sequence) const {
+        assert(static_cast<int>(sequence.size()) == length());
+        assert(std::equal(prefix.begin(), prefix.end(), sequence.begin()));
+
+        int offset = static_cast<int>(prefix.size());
+        int numOfDigits = static_cast<int>(radixes.size());
+
+        int64_t index = 0;
+        int bit = firstBagBit;
+        for (int position = 0; position < numOfDigits; ++position) {
+            if (bit == 0) {
+                bit = kAllPieceBit;
+            }
+
+            int pieceBit = 1 << sequence[offset + position];
+            assert((bit & pieceBit) != 0);
+
+            int digit = bitCount7(bit & (pieceBit - 1));
+            index = index * radixes[position] + digit;
+
+            if (isBag) {
+                bit &= ~pieceBit;
+            } else {
+                bit = kAllPieceBit;
+            }
+        }
+
+        return index;
+    }
+
+    Sequence SequenceSpace::unrank(int64_t index) const {
+        assert(0 <= index && index < numOfSequences);
+
+        int numOfDigits = static_cast<int>(radixes.size());
+
+        auto digits = std::vector<int>(numOfDigits);
+        for (int position = numOfDigits - 1; 0 <= position; --position) {
+            digits[position] = static_cast<int>(index % radixes[position]);
+            index /= radixes[position];
+        }
+
+        auto sequence = Sequence(prefix);
+        sequence.resize(length());
+        fill(sequence, digits, 0);
+        return sequence;
+    }
+
+    Chunk SequenceSpace::getChunk(int chunkIndex, int numOfChunks) const {
+        assert(0 <= chunkIndex && chunkIndex < numOfChunks);
+
+        int64_t quotient = numOfSequences / numOfChunks;
+        int64_t remainder = numOfSequences % numOfChunks;
+
+        // The first `remainder` chunks have one more index
+        auto begin = quotient * chunkIndex + std::min<int64_t>(chunkIndex, remainder);
+        auto end = begin + quotient + (chunkIndex < remainder ? 1 : 0);
+        return Chunk{begin, end};
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef FINDER_SEQUENCE_SPACE_HPP
+#define FINDER_SEQUENCE_SPACE_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../core/types.hpp"
+
+namespace finder {
+    using Sequence = std::vector<core::PieceType>;
+
+    // A range of sequence indexes [begin, end)
+    struct Chunk {
+        int64_t begin;
+        int64_t end;
+    };
+
+    // All sequences of a fixed length in lexicographic order: a known prefix followed by free pieces.
+    // The index is a mixed radix number whose digit at each position is the number of smaller pieces available there,
+    // so rank and unrank are O(length)
+    class SequenceSpace {
+    public:
+        // Orders of `length` distinct pieces. The index is the same as `toPieces`
+        static SequenceSpace createPermutations(int length);
+
+        // `prefix` followed by pieces drawn from 7-bags.
+        // `firstBagBit` is the set of pieces (1 << PieceType) left in the bag right after the prefix
+        static SequenceSpace createBag(const Sequence &prefix, int length, int firstBagBit);
+
+        static SequenceSpace createBag(const Sequence &prefix, int length);
+
+        // `prefix` followed by any pieces
+        static SequenceSpace createRepetition(const Sequence &prefix, int length);
+
+        int64_t size() const {
+            return numOfSequences;
+        }
+
+        int length() const {
+            return static_cast<int>(prefix.size() + radixes.size());
+        }
+
+        int64_t rank(const Sequence &sequence) const;
+
+        Sequence unrank(int64_t index) const;
+
+        // Splits all indexes into `numOfChunks` contiguous chunks whose sizes differ by at most one
+        Chunk getChunk(int chunkIndex, int numOfChunks) const;
+
+        // Calls `callback(index, const Sequence &)` for each index in the chunk in order.
+        // Each step updates only the positions after the last changed digit
+        template<class F>
+        void forEach(const Chunk &chunk, F &&callback) const;
+
+        template<class F>
+        void forEach(F &&callback) const {
+            forEach(Chunk{0, numOfSequences}, callback);
+        }
+
+    private:
+        SequenceSpace(const Sequence &prefix, int length, int firstBagBit, bool isBag);
+
+        const Sequence prefix;
+        const int firstBagBit;
+        const bool isBag;
+
+        // The number of available pieces at each free position
+        std::vector<int> radixes;
+        int64_t numOfSequences;
+
+        // Fills the free positions from `start` with the pieces selected by the digits
+        void fill(Sequence &sequence, const std::vector<int> &digits, int start) const;
+
+        int getAvailableBit(const Sequence &sequence, int position) const;
+    };
+
+    template<class F>
+    void SequenceSpace::forEach(const Chunk &chunk, F &&callback) const {
+        assert(0 <= chunk.begin && chunk.begin <= chunk.end && chunk.end <= numOfSequences);
+        if (chunk.begin == chunk.end) {
+            return;
+        }
+
+        int numOfDigits = static_cast<int>(radixes.size());
+
+        auto sequence = unrank(chunk.begin);
+        auto digits = std::vector<int>(numOfDigits);
+        int64_t rest = chunk.begin;
+        for (int position = numOfDigits - 1; 0 <= position; --position) {
+            digits[position] = static_cast<int>(rest % radixes[position]);
+            rest /= radixes[position];
+        }
+
+        for (int64_t index = chunk.begin; index < chunk.end; ++index) {
+            callback(index, static_cast<const Sequence &>(sequence));
+
+            // Increment the digits
+            int position = numOfDigits - 1;
+            while (0 <= position && radixes[position] <= digits[position] + 1) {
+                digits[position] = 0;
+                position -= 1;
+            }
+            if (position < 0) {
+                break;
+            }
+            digits[position] += 1;
+
+            fill(sequence, digits, position);
+        }
+    }
+}
+
+#endif //FINDER_SEQUENCE_SPACE_HPP
@@ -0,0 +1,25 @@
+#ifndef TEST_CORE_RANDOM_FIELD_HPP
+#define TEST_CORE_RANDOM_FIELD_HPP
+
+#include <random>
+
+#include "core/field.hpp"
+
+namespace core {
+    // Returns a field of random blocks below `height`, denser at the bottom and with overhangs.
+    // The density of the bottom row is less than 80%, and each row above loses `slope`%
+    inline Field createRandomField(std::mt19937 &random, int height, int slope) {
+        auto field = Field{};
+        int density = static_cast<int>(random() % 80);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < FIELD_WIDTH; ++x) {
+                if (static_cast<int>(random() % 100) < density - y * slope) {
+                    field.setBlock(x, y);
+                }
+            }
+        }
+        return field;
+    }
+}
+
+#endif //TEST_CORE_RANDOM_FIELD_HPP
@@ -1,4 +1,7 @@
 #include "gtest/gtest.h"
+
+#include <unordered_set>
+
 #include "core/field.hpp"
 #include "core/piece.hpp"
 
@@ -104,4 +107,156 @@ namespace core {
         EXPECT_FALSE(field.canPut(blocks, 5, 4));
         EXPECT_FALSE(field.canPut(blocks, 6, 5));
     }
+
+    TEST_F(FieldTest, lineWithKey) {
+        // Full rows at y = 1, 4, 5, 6, 7, 8, 12, 20
+        auto field = Field{};
+        for (int y = 0; y < 24; ++y) {
+            bool full = y == 1 || y == 4 || y == 5 || y == 6 || y == 7 || y == 8 || y == 12 || y == 20;
+            for (int x = 0; x < 10; ++x) {
+                // A different row for each y
+                if (full || x < y % 9 || (x == 9 && y % 2 == 0)) {
+                    field.setBlock(x, y);
+                }
+            }
+        }
+
+        auto cleared = Field(field);
+        LineKey key = cleared.clearLineReturnKey();
+        EXPECT_EQ(bitCount(key), 8);
+
+        {
+            auto freeze = Field(field);
+            freeze.deleteLineWithKey(key);
+            EXPECT_EQ(freeze, cleared);
+        }
+
+        {
+            auto freeze = Field(cleared);
+            freeze.insertBlackLineWithKey(key);
+            EXPECT_EQ(freeze, field);
+        }
+
+        {
+            auto freeze = Field(cleared);
+            freeze.insertWhiteLineWithKey(key);
+            for (int y = 0; y < 24; ++y) {
+                bool inserted = (key & (1ULL << ((y % 6) * 10 + y / 6))) != 0;
+                for (int x = 0; x < 10; ++x) {
+                    EXPECT_EQ(freeze.isEmpty(x, y), inserted || field.isEmpty(x, y));
+                }
+            }
+        }
+
+        {
+            // Only the rows in the low board
+            LineKey lowKey = key & 0x4010040100401ULL;
+            auto freeze = Field(field);
+            freeze.deleteLineWithKey(lowKey);
+            freeze.insertBlackLineWithKey(lowKey);
+            EXPECT_EQ(freeze, field);
+        }
+    }
+
+    TEST_F(FieldTest, mirror) {
+        auto field = Field{};
+        for (int y = 0; y < 24; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                if ((x * 7 + y * 3) % 5 < 2) {
+                    field.setBlock(x, y);
+                }
+            }
+        }
+
+        auto freeze = Field(field);
+        freeze.mirror();
+        for (int y = 0; y < 24; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                EXPECT_EQ(freeze.isEmpty(x, y), field.isEmpty(9 - x, y));
+            }
+        }
+
+        freeze.mirror();
+        EXPECT_EQ(freeze, field);
+    }
+
+    TEST_F(FieldTest, hash) {
+        auto factory = Factory::create();
+
+        // Returns the field with the same blocks built from the empty field
+        auto rebuild = [](const Field &field) {
+            auto result = Field{};
+            for (int y = 0; y < 24; ++y) {
+                for (int x = 0; x < 10; ++x) {
+                    if (!field.isEmpty(x, y)) {
+                        result.setBlock(x, y);
+                    }
+                }
+            }
+            return result;
+        };
+
+        auto field = createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXXX_"s +
+                "XXXXXXXXX_"s +
+                "XXXXXX____"s +
+                ""
+        );
+        EXPECT_EQ(field.hash(), rebuild(field).hash());
+
+        field.put(factory.get(PieceType::I, RotateType::Left), 9, 2);
+        EXPECT_EQ(field.hash(), rebuild(field).hash());
+
+        // The removed cells are empty, and the hash is the one of the field built without them
+        auto &iBlocks = factory.get(PieceType::I, RotateType::Left);
+        field.remove(iBlocks, 9, 2);
+        for (const auto &point : iBlocks.points) {
+            EXPECT_TRUE(field.isEmpty(9 + point.x, 2 + point.y));
+        }
+        auto expected = createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXXX_"s +
+                "XXXXXXXXX_"s +
+                "XXXXXX____"s +
+                ""
+        );
+        EXPECT_EQ(field, expected);
+        EXPECT_EQ(field.hash(), expected.hash());
+
+        field.put(factory.get(PieceType::T, RotateType::Spawn), 4, 6);
+        EXPECT_EQ(field.hash(), rebuild(field).hash());
+
+        field.put(iBlocks, 9, 2);
+        auto key = field.clearLineReturnKey();
+        EXPECT_NE(key, 0);
+        EXPECT_EQ(field.hash(), rebuild(field).hash());
+
+        field.insertBlackLineWithKey(key);
+        EXPECT_EQ(field.hash(), rebuild(field).hash());
+
+        field.mirror();
+        EXPECT_EQ(field.hash(), rebuild(field).hash());
+
+        // No collisions over the fields after two placements
+        std::unordered_set<Field> fields{};
+        std::unordered_set<uint64_t> hashes{};
+        auto empty = Field{};
+        for (int first = 0; first < 7; ++first) {
+            for (int second = 0; second < 7; ++second) {
+                auto &firstBlocks = factory.get(static_cast<PieceType>(first), RotateType::Spawn);
+                auto &secondBlocks = factory.get(static_cast<PieceType>(second), RotateType::Right);
+                for (int x1 = -firstBlocks.minX; x1 < 10 - firstBlocks.maxX; ++x1) {
+                    for (int x2 = -secondBlocks.minX; x2 < 10 - secondBlocks.maxX; ++x2) {
+                        auto freeze = Field(empty);
+                        freeze.put(firstBlocks, x1, freeze.getYOnHarddrop(firstBlocks, x1, 20));
+                        freeze.put(secondBlocks, x2, freeze.getYOnHarddrop(secondBlocks, x2, 20));
+                        fields.insert(freeze);
+                        hashes.insert(std::hash<Field>{}(freeze));
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(fields.size(), hashes.size());
+    }
 }
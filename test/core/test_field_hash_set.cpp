@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <random>
+#include <thread>
+#include <unordered_set>
+
+#include "core/field.hpp"
+#include "core/field_hash_set.hpp"
+
+namespace core {
+    class FieldHashSetTest : public ::testing::Test {
+    };
+
+    namespace {
+        // Fields of 4 rows with many duplicates
+        std::vector<Field> createRandomFields(int size, int seed) {
+            auto random = std::mt19937(seed);
+            auto fields = std::vector<Field>{};
+            for (int index = 0; index < size; ++index) {
+                auto field = Field{};
+                for (int y = 0; y < 4; ++y) {
+                    field.setBlock(static_cast<int>(random() % 10), y);
+                }
+                if (random() % 2 == 0) {
+                    field.setBlock(static_cast<int>(random() % 10), 20);
+                }
+                fields.push_back(field);
+            }
+            return fields;
+        }
+    }
+
+    TEST_F(FieldHashSetTest, insert) {
+        auto fields = createRandomFields(20000, 1);
+
+        auto set = FieldHashSet(fields.size());
+        auto expected = std::unordered_set<Field>{};
+        for (const auto &field : fields) {
+            EXPECT_EQ(set.contains(field), expected.count(field) != 0);
+            EXPECT_EQ(set.insert(field), expected.insert(field).second);
+        }
+        EXPECT_EQ(set.size(), expected.size());
+        EXPECT_LE(fields.size() * 2, set.capacity());
+
+        for (const auto &field : createRandomFields(1000, 2)) {
+            EXPECT_EQ(set.contains(field), expected.count(field) != 0);
+        }
+
+        set.clear();
+        EXPECT_EQ(set.size(), 0);
+        EXPECT_FALSE(set.contains(fields[0]));
+        EXPECT_TRUE(set.insert(fields[0]));
+    }
+
+    TEST_F(FieldHashSetTest, concurrentInsert) {
+        const int numOfThreads = 4;
+        auto fields = createRandomFields(20000, 3);
+        auto expected = std::unordered_set<Field>(fields.begin(), fields.end());
+
+        auto set = ConcurrentFieldHashSet(fields.size());
+
+        // All threads insert all fields from different positions
+        std::vector<int> inserted(numOfThreads, 0);
+        std::vector<std::thread> threads{};
+        for (int thread = 0; thread < numOfThreads; ++thread) {
+            threads.emplace_back([&, thread]() {
+                for (size_t index = 0; index < fields.size(); ++index) {
+                    auto &field = fields[(index + thread * fields.size() / numOfThreads) % fields.size()];
+                    if (set.insert(field)) {
+                        inserted[thread] += 1;
+                    }
+                    EXPECT_TRUE(set.contains(field));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        int total = 0;
+        for (int count : inserted) {
+            total += count;
+        }
+        EXPECT_EQ(total, static_cast<int>(expected.size()));
+        EXPECT_EQ(set.size(), expected.size());
+
+        for (const auto &field : createRandomFields(1000, 4)) {
+            EXPECT_EQ(set.contains(field), expected.count(field) != 0);
+        }
+    }
+
+    TEST_F(FieldHashSetTest, insertPastMaxSize) {
+        const size_t maxSize = 100;
+
+        // Distinct fields with one block
+        auto fields = std::vector<Field>{};
+        for (int y = 0; y < 24; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                auto field = Field{};
+                field.setBlock(x, y);
+                fields.push_back(field);
+            }
+        }
+
+        auto set = FieldHashSet(maxSize);
+        auto concurrentSet = ConcurrentFieldHashSet(maxSize);
+        for (size_t index = 0; index < fields.size(); ++index) {
+            EXPECT_EQ(set.insert(fields[index]), index < maxSize);
+            EXPECT_EQ(concurrentSet.insert(fields[index]), index < maxSize);
+        }
+        EXPECT_EQ(set.size(), maxSize);
+        EXPECT_EQ(concurrentSet.size(), maxSize);
+
+        for (size_t index = 0; index < fields.size(); ++index) {
+            EXPECT_EQ(set.contains(fields[index]), index < maxSize);
+            EXPECT_EQ(concurrentSet.contains(fields[index]), index < maxSize);
+        }
+    }
+}
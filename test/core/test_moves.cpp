@@ -1,7 +1,10 @@
 #include "gtest/gtest.h"
 
+#include <random>
+
 #include "core/field.hpp"
 #include "core/moves.hpp"
+#include "random_field.hpp"
 
 namespace core {
     using namespace std::literals::string_literals;
@@ -52,6 +55,50 @@ namespace core {
 
     }
 
+    class LandableMaskTest : public ::testing::Test {
+    };
+
+    TEST_F(LandableMaskTest, sameAsCanPutOnGround) {
+        auto field = createField(
+                "__________"s +
+                "X_________"s +
+                "XX_____X__"s +
+                "XXX_X__XX_"s +
+                "X_XXX_XXXX"s +
+                "XXXX_XXXXX"s +
+                "XXXXXXX_XX"s +
+                "_XXXXXXXXX"s +
+                ""
+        );
+
+        auto factory = Factory::create();
+        auto columns = field.getColumns();
+        for (int x = 0; x < FIELD_WIDTH; ++x) {
+            for (int y = 0; y < MAX_FIELD_HEIGHT; ++y) {
+                EXPECT_EQ((columns[x] >> y) & 1U, field.isEmpty(x, y) ? 0U : 1U);
+            }
+        }
+
+        for (int validHeight : {4, 8, 24}) {
+            for (int piece = 0; piece < 7; ++piece) {
+                for (int rotate = 0; rotate < 4; ++rotate) {
+                    auto &blocks = factory.get(static_cast<PieceType>(piece), static_cast<RotateType>(rotate));
+
+                    auto mask = LandableMask{};
+                    getLandableMask(mask, columns, blocks, validHeight);
+
+                    for (int x = -blocks.minX; x < FIELD_WIDTH - blocks.maxX; ++x) {
+                        for (int y = -blocks.minY; y < MAX_FIELD_HEIGHT - blocks.maxY; ++y) {
+                            bool expected = y < validHeight - blocks.maxY
+                                            && field.canPut(blocks, x, y) && field.isOnGround(blocks, x, y);
+                            EXPECT_EQ(((mask[x] >> y) & 1U) != 0, expected);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     namespace srs {
         class SRSMoveGeneratorTest : public ::testing::Test {
         };
@@ -171,6 +218,139 @@ namespace core {
                 EXPECT_FALSE(assertMove(moves, Move{RotateType::Spawn, 4, 0, false}));
             }
         }
+
+        TEST_F(SRSMoveGeneratorTest, withoutOverhangs) {
+            auto field = createField(
+                    "X_______XX"s +
+                    "XX__X__XXX"s +
+                    "XXX_XX_XXX"s +
+                    "XXXXXX_XXX"s +
+                    ""
+            );
+
+            auto factory = Factory::create();
+            auto generator = srs::MoveGenerator(factory);
+            auto iterative = srs_iterative::MoveGenerator(factory);
+
+            // All landings are reachable by harddrop, in the same order as the full search
+            for (int piece = 0; piece < 7; ++piece) {
+                auto expected = std::vector<Move>();
+                iterative.search(expected, field, static_cast<PieceType>(piece), 6);
+
+                auto moves = std::vector<Move>();
+                generator.search(moves, field, static_cast<PieceType>(piece), 6);
+
+                EXPECT_EQ(moves, expected);
+                for (const auto &move : moves) {
+                    EXPECT_TRUE(move.harddrop);
+                }
+            }
+        }
+    }
+
+    namespace srs_iterative {
+        class SRSIterativeMoveGeneratorTest : public ::testing::Test {
+        };
+
+        TEST_F(SRSIterativeMoveGeneratorTest, sameAsRecursive) {
+            for (const auto &factory : {Factory::create(), Factory::createForSSRPlus()}) {
+                auto recursive = srs::MoveGenerator(factory);
+                auto iterative = srs_iterative::MoveGenerator(factory);
+
+                auto random = std::mt19937(1);
+                for (int count = 0; count < 300; ++count) {
+                    int height = 2 + static_cast<int>(random() % 14);
+                    auto field = createRandomField(random, height, 4);
+
+                    int validHeight = std::min(height + 2, 20);
+                    for (int piece = 0; piece < 7; ++piece) {
+                        auto expected = std::vector<Move>();
+                        recursive.search(expected, field, static_cast<PieceType>(piece), validHeight);
+
+                        auto moves = std::vector<Move>();
+                        iterative.search(moves, field, static_cast<PieceType>(piece), validHeight);
+
+                        EXPECT_EQ(moves, expected);
+                    }
+                }
+            }
+        }
+
+        TEST_F(SRSIterativeMoveGeneratorTest, multiplePieces) {
+            auto field = createField(
+                    "X_________"s +
+                    "XX_____X__"s +
+                    "XXX_X__XX_"s +
+                    "X_XXX_XXXX"s +
+                    "XXXX_XXXXX"s +
+                    ""
+            );
+
+            auto factory = Factory::create();
+            auto generator = srs_iterative::MoveGenerator(factory);
+
+            // Lists of the pieces not in the bit are kept
+            auto movesByPiece = std::array<std::vector<Move>, 7>{};
+            movesByPiece[PieceType::O].push_back(Move{RotateType::Spawn, 0, 0, true});
+
+            int pieceBit = (1 << PieceType::T) | (1 << PieceType::I) | (1 << PieceType::S);
+            generator.search(movesByPiece, field, pieceBit, 6);
+
+            for (int piece = 0; piece < 7; ++piece) {
+                auto expected = std::vector<Move>();
+                if ((pieceBit & (1 << piece)) != 0) {
+                    generator.search(expected, field, static_cast<PieceType>(piece), 6);
+                    EXPECT_FALSE(expected.empty());
+                } else if (piece == PieceType::O) {
+                    expected.push_back(Move{RotateType::Spawn, 0, 0, true});
+                }
+                EXPECT_EQ(movesByPiece[piece], expected);
+            }
+        }
+
+        TEST_F(SRSIterativeMoveGeneratorTest, classifies) {
+            auto factory = Factory::create();
+            auto generator = srs_iterative::MoveGenerator(factory);
+            auto classifier = srs_iterative::MoveGenerator(factory, true);
+
+            // TST
+            auto field = createField(
+                    "________XX"s +
+                    "_________X"s +
+                    "XXXXXXXX_X"s +
+                    "XXXXXXX__X"s +
+                    "XXXXXXXX_X"s +
+                    ""
+            );
+
+            auto expected = std::vector<Move>();
+            generator.search(expected, field, PieceType::T, 8);
+
+            auto moves = std::vector<Move>();
+            classifier.search(moves, field, PieceType::T, 8);
+
+            ASSERT_EQ(moves.size(), expected.size());
+            for (size_t index = 0; index < moves.size(); ++index) {
+                auto move = moves[index];
+                EXPECT_NE(move.lastAction, LastActions::Unclassified);
+
+                move.lastAction = LastActions::Unclassified;
+                EXPECT_EQ(move, expected[index]);
+            }
+
+            auto find = [&](RotateType rotateType, int x, int y) {
+                for (const auto &move : moves) {
+                    if (move.rotateType == rotateType && move.x == x && move.y == y) {
+                        return move.lastAction;
+                    }
+                }
+                return LastActions::Unclassified;
+            };
+
+            EXPECT_EQ(find(RotateType::Left, 8, 1), LastActions::RotateLastWithLastKick);
+            EXPECT_EQ(find(RotateType::Spawn, 4, 3), LastActions::MoveLast);
+            EXPECT_EQ(find(RotateType::Right, 3, 4), LastActions::RotateLast);
+        }
     }
 
     namespace srs_rotate_end {
@@ -265,5 +445,34 @@ namespace core {
                 EXPECT_FALSE(reachable.checks(field, PieceType::O, RotateType::Left, 3, 0, 24));
             }
         }
+
+        TEST_F(SRSRotateEndReachableTest, fromReachedPositions) {
+            for (const auto &factory : {Factory::create(), Factory::createForSSRPlus()}) {
+                auto reachable = srs_rotate_end::Reachable(factory);
+                auto generator = srs_iterative::MoveGenerator(factory);
+
+                auto random = std::mt19937(2);
+                for (int count = 0; count < 200; ++count) {
+                    int height = 2 + static_cast<int>(random() % 10);
+                    auto field = createRandomField(random, height, 4);
+
+                    int validHeight = height + 2;
+                    for (int piece = 0; piece < 7; ++piece) {
+                        auto pieceType = static_cast<PieceType>(piece);
+
+                        auto moves = std::vector<Move>();
+                        generator.search(moves, field, pieceType, validHeight);
+
+                        auto &positions = generator.getReachedPositions();
+                        for (const auto &move : moves) {
+                            EXPECT_EQ(
+                                    reachable.checks(positions, pieceType, move.rotateType, move.x, move.y),
+                                    reachable.checks(field, pieceType, move.rotateType, move.x, move.y, validHeight)
+                            );
+                        }
+                    }
+                }
+            }
+        }
     }
 }
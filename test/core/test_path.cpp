@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+#include "core/moves.hpp"
+#include "core/path.hpp"
+#include "random_field.hpp"
+
+namespace core {
+    using namespace std::literals::string_literals;
+
+    class PathTest : public ::testing::Test {
+    };
+
+    namespace {
+        // Replays the inputs from the appearance, and returns the field with the piece locked
+        Field replay(
+                const Factory &factory, const Field &field, PieceType pieceType,
+                const std::vector<Inputs> &inputs, int validHeight
+        ) {
+            auto &piece = factory.get(pieceType);
+            auto rotateType = RotateType::Spawn;
+            int x = 4;
+            int y = validHeight;
+
+            for (const auto &input : inputs) {
+                auto &blocks = piece.blocks[rotateType];
+                switch (input) {
+                    case Inputs::ShiftLeft:
+                        EXPECT_TRUE(field.canPut(blocks, x - 1, y));
+                        x -= 1;
+                        break;
+                    case Inputs::ShiftRight:
+                        EXPECT_TRUE(field.canPut(blocks, x + 1, y));
+                        x += 1;
+                        break;
+                    case Inputs::RotateRight: {
+                        auto toRotate = static_cast<RotateType>((rotateType + 1) % 4);
+                        int index = srs::right(field, piece, rotateType, toRotate, x, y);
+                        EXPECT_LE(0, index);
+                        x += piece.rightOffsets[index].x;
+                        y += piece.rightOffsets[index].y;
+                        rotateType = toRotate;
+                        break;
+                    }
+                    case Inputs::RotateLeft: {
+                        auto toRotate = static_cast<RotateType>((rotateType + 3) % 4);
+                        int index = srs::left(field, piece, rotateType, toRotate, x, y);
+                        EXPECT_LE(0, index);
+                        x += piece.leftOffsets[index].x;
+                        y += piece.leftOffsets[index].y;
+                        rotateType = toRotate;
+                        break;
+                    }
+                    case Inputs::SoftDrop:
+                        EXPECT_TRUE(field.canPut(blocks, x, y - 1));
+                        y -= 1;
+                        break;
+                    case Inputs::HardDrop:
+                        y = field.getYOnHarddrop(blocks, x, y);
+                        break;
+                }
+            }
+
+            auto freeze = Field(field);
+            freeze.put(piece.blocks[rotateType], x, y);
+            return freeze;
+        }
+    }
+
+    TEST_F(PathTest, harddrop) {
+        auto factory = Factory::create();
+        auto field = Field{};
+
+        auto inputs = std::vector<Inputs>();
+        EXPECT_TRUE(findInputs(inputs, factory, field, PieceType::T, RotateType::Spawn, 4, 0, 4));
+        EXPECT_EQ(inputs, (std::vector<Inputs>{Inputs::HardDrop}));
+
+        // A rotation and 4 shifts in any order
+        EXPECT_TRUE(findInputs(inputs, factory, field, PieceType::I, RotateType::Left, 0, 1, 4));
+        EXPECT_EQ(inputs.size(), 6u);
+        EXPECT_EQ(std::count(inputs.begin(), inputs.end(), Inputs::ShiftLeft), 4);
+        EXPECT_EQ(inputs.back(), Inputs::HardDrop);
+
+        auto expected = Field(field);
+        expected.put(factory.get(PieceType::I, RotateType::Left), 0, 1);
+        EXPECT_EQ(replay(factory, field, PieceType::I, inputs, 4), expected);
+    }
+
+    TEST_F(PathTest, tst) {
+        auto factory = Factory::create();
+        auto field = createField(
+                "________XX"s +
+                "_________X"s +
+                "XXXXXXXX_X"s +
+                "XXXXXXX__X"s +
+                "XXXXXXXX_X"s +
+                ""
+        );
+
+        auto inputs = std::vector<Inputs>();
+        ASSERT_TRUE(findInputs(inputs, factory, field, PieceType::T, RotateType::Left, 8, 1, 6));
+
+        // The last kick into the slot
+        ASSERT_LE(2, inputs.size());
+        auto last = inputs[inputs.size() - 2];
+        EXPECT_TRUE(last == Inputs::RotateRight || last == Inputs::RotateLeft);
+        EXPECT_EQ(inputs.back(), Inputs::HardDrop);
+
+        auto expected = Field(field);
+        expected.put(factory.get(PieceType::T, RotateType::Left), 8, 1);
+        EXPECT_EQ(replay(factory, field, PieceType::T, inputs, 6), expected);
+    }
+
+    TEST_F(PathTest, unreachable) {
+        auto factory = Factory::create();
+        auto field = createField(
+                "XXXXXXXXXX"s +
+                "X___XXXXXX"s +
+                "XX_XXXXXXX"s +
+                ""
+        );
+
+        auto inputs = std::vector<Inputs>{Inputs::HardDrop};
+        EXPECT_FALSE(findInputs(inputs, factory, field, PieceType::T, RotateType::Reverse, 2, 1, 6));
+        EXPECT_TRUE(inputs.empty());
+    }
+
+    TEST_F(PathTest, top) {
+        auto factory = Factory::create();
+        auto field = Field{};
+        const int validHeight = MAX_FIELD_HEIGHT - 2;
+
+        // The rotations near the top stay in the field
+        for (int piece = 0; piece < 7; ++piece) {
+            auto pieceType = static_cast<PieceType>(piece);
+            for (int rotate = 0; rotate < 4; ++rotate) {
+                auto rotateType = static_cast<RotateType>(rotate);
+                auto &blocks = factory.get(pieceType, rotateType);
+                for (int x = -blocks.minX; x < FIELD_WIDTH - blocks.maxX; ++x) {
+                    int y = -blocks.minY;
+
+                    auto inputs = std::vector<Inputs>();
+                    ASSERT_TRUE(findInputs(inputs, factory, field, pieceType, rotateType, x, y, validHeight));
+
+                    auto expected = Field(field);
+                    expected.put(blocks, x, y);
+                    EXPECT_EQ(replay(factory, field, pieceType, inputs, validHeight), expected);
+                }
+            }
+        }
+
+        // The piece cannot appear above the field
+        auto inputs = std::vector<Inputs>();
+        EXPECT_FALSE(findInputs(inputs, factory, field, PieceType::T, RotateType::Spawn, 4, 0, MAX_FIELD_HEIGHT - 1));
+    }
+
+    TEST_F(PathTest, blockedAppearance) {
+        auto factory = Factory::create();
+        auto field = Field{};
+        for (int y = 0; y <= 4; ++y) {
+            field.setBlock(4, y);
+        }
+
+        // The move generators enter the field from any column, but the piece appears on the blocks
+        auto moves = std::vector<Move>();
+        auto generator = srs::MoveGenerator(factory);
+        generator.search(moves, field, PieceType::T, 4);
+        EXPECT_TRUE(std::any_of(moves.begin(), moves.end(), [](const Move &move) {
+            return move.rotateType == RotateType::Spawn && move.x == 1 && move.y == 0;
+        }));
+
+        auto inputs = std::vector<Inputs>();
+        EXPECT_FALSE(findInputs(inputs, factory, field, PieceType::T, RotateType::Spawn, 1, 0, 4));
+        EXPECT_TRUE(findInputs(inputs, factory, field, PieceType::T, RotateType::Spawn, 1, 0, 5));
+    }
+
+    TEST_F(PathTest, sameAsMoves) {
+        auto factory = Factory::create();
+        auto generator = srs::MoveGenerator(factory);
+
+        auto random = std::mt19937(3);
+        for (int count = 0; count < 30; ++count) {
+            auto field = createRandomField(random, 6, 10);
+
+            for (int piece = 0; piece < 7; ++piece) {
+                auto pieceType = static_cast<PieceType>(piece);
+
+                auto moves = std::vector<Move>();
+                generator.search(moves, field, pieceType, 8);
+
+                auto inputs = std::vector<Inputs>();
+                for (const auto &move : moves) {
+                    ASSERT_TRUE(findInputs(inputs, factory, field, pieceType, move.rotateType, move.x, move.y, 8));
+
+                    auto expected = Field(field);
+                    expected.put(factory.get(pieceType, move.rotateType), move.x, move.y);
+                    EXPECT_EQ(replay(factory, field, pieceType, inputs, 8), expected);
+
+                    if (move.harddrop) {
+                        EXPECT_EQ(std::count(inputs.begin(), inputs.end(), Inputs::SoftDrop), 0);
+                    }
+                }
+            }
+        }
+    }
+}
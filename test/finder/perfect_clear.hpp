@@ -0,0 +1,42 @@
+#ifndef TEST_FINDER_PERFECT_CLEAR_HPP
+#define TEST_FINDER_PERFECT_CLEAR_HPP
+
+#include "core/field.hpp"
+#include "finder/perfect.hpp"
+
+namespace finder {
+    // Replays the operations. If `onGround`, each piece must be on the ground where it is placed
+    inline bool replaysPerfectClear(
+            const core::Factory &factory, core::Field field, const Solution &solution, int maxLine, bool onGround
+    ) {
+        int leftLine = maxLine;
+        for (const auto &operation : solution) {
+            auto &blocks = factory.get(operation.pieceType, operation.rotateType);
+            if (!field.canPut(blocks, operation.x, operation.y)) {
+                return false;
+            }
+            if (onGround && !field.isOnGround(blocks, operation.x, operation.y)) {
+                return false;
+            }
+            field.put(blocks, operation.x, operation.y);
+            leftLine -= field.clearLineReturnNum();
+        }
+        return leftLine == 0 && field == core::Field();
+    }
+
+    // Returns true if the operations, each in the field at the time it is placed, clear `maxLine` lines to the empty field
+    inline bool isPerfectClear(
+            const core::Factory &factory, const core::Field &field, const Solution &solution, int maxLine
+    ) {
+        return replaysPerfectClear(factory, field, solution, maxLine, false);
+    }
+
+    // The same as `isPerfectClear`, and each piece is on the ground where it is placed
+    inline bool isPerfectClearOnGround(
+            const core::Factory &factory, const core::Field &field, const Solution &solution, int maxLine
+    ) {
+        return replaysPerfectClear(factory, field, solution, maxLine, true);
+    }
+}
+
+#endif //TEST_FINDER_PERFECT_CLEAR_HPP
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/batch.hpp"
+#include "perfect_clear.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class BatchTest : public ::testing::Test {
+    };
+
+    TEST_F(BatchTest, mirroredQuery) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = BatchFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXX______"s +
+                "XXXX______"s +
+                "XXXX_____X"s +
+                "XXXXX___XX"s +
+                ""
+        );
+        auto mirrorField = core::Field(field);
+        mirrorField.mirror();
+        ASSERT_NE(field, mirrorField);
+
+        auto pieces = Sequence{
+                core::PieceType::T, core::PieceType::S, core::PieceType::Z, core::PieceType::L, core::PieceType::J,
+        };
+
+        auto queries = std::vector<Query>{
+                Query{field, pieces},
+                Query{mirrorField, mirror(pieces)},
+                Query{field, pieces},
+        };
+        auto results = finder.run(queries, 5, 4, false);
+
+        // The mirrored query is served by the solution of the first one
+        EXPECT_EQ(finder.numOfSearches(), 1);
+        ASSERT_EQ(results.size(), 3u);
+        for (size_t index = 0; index < results.size(); ++index) {
+            ASSERT_FALSE(results[index].empty());
+            EXPECT_TRUE(isPerfectClearOnGround(factory, queries[index].field, results[index], 4));
+        }
+
+        auto mirrored = mirror(factory, results[0]);
+        ASSERT_EQ(mirrored.size(), results[1].size());
+        for (size_t index = 0; index < mirrored.size(); ++index) {
+            EXPECT_EQ(mirrored[index].pieceType, results[1][index].pieceType);
+            EXPECT_EQ(mirrored[index].rotateType, results[1][index].rotateType);
+            EXPECT_EQ(mirrored[index].x, results[1][index].x);
+            EXPECT_EQ(mirrored[index].y, results[1][index].y);
+        }
+    }
+
+    TEST_F(BatchTest, asymmetricKicks) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto finder = BatchFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXX______"s +
+                "XXXX______"s +
+                "XXXX_____X"s +
+                "XXXXX___XX"s +
+                ""
+        );
+        auto mirrorField = core::Field(field);
+        mirrorField.mirror();
+
+        auto pieces = Sequence{
+                core::PieceType::I, core::PieceType::S, core::PieceType::T, core::PieceType::L, core::PieceType::O,
+        };
+
+        auto queries = std::vector<Query>{
+                Query{field, pieces},
+                Query{mirrorField, mirror(pieces)},
+        };
+        auto results = finder.run(queries, 5, 4, false);
+
+        // The kicks of I are not symmetric, so each query is searched
+        EXPECT_EQ(finder.numOfSearches(), 2);
+        ASSERT_EQ(results.size(), 2u);
+        for (size_t index = 0; index < results.size(); ++index) {
+            auto &query = queries[index];
+            auto solution = perfectFinder.run(query.field, query.sequence, 5, 4, false);
+            EXPECT_EQ(results[index].empty(), solution.empty());
+            if (!results[index].empty()) {
+                EXPECT_TRUE(isPerfectClearOnGround(factory, query.field, results[index], 4));
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/count.hpp"
+#include "finder/enumerate.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class CountTest : public ::testing::Test {
+    };
+
+    TEST_F(CountTest, case1) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = CountFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXXX__XXX"s +
+                "XXXX__XXXX"s +
+                ""
+        );
+
+        EXPECT_EQ(finder.run(field, std::vector{core::PieceType::S}, 1, 2, true), 1);
+        EXPECT_EQ(finder.run(field, std::vector{core::PieceType::Z}, 1, 2, true), 0);
+        EXPECT_EQ(finder.run(field, std::vector{core::PieceType::Z, core::PieceType::S}, 1, 2, false), 1);
+    }
+
+    TEST_F(CountTest, sameAsEnumerate) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = CountFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto enumerateFinder = EnumerateFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto maxDepth = 7;
+        auto maxLine = 6;
+
+        auto piecesList = std::vector{
+                std::vector{
+                        core::PieceType::J, core::PieceType::O, core::PieceType::T, core::PieceType::Z,
+                        core::PieceType::S, core::PieceType::O, core::PieceType::L
+                },
+                std::vector{
+                        core::PieceType::I, core::PieceType::J, core::PieceType::T, core::PieceType::Z,
+                        core::PieceType::O, core::PieceType::S, core::PieceType::L
+                },
+                std::vector{
+                        core::PieceType::J, core::PieceType::I, core::PieceType::T, core::PieceType::Z,
+                        core::PieceType::S, core::PieceType::O, core::PieceType::L
+                },
+        };
+
+        for (const auto &pieces : piecesList) {
+            for (bool holdEmpty : {false, true}) {
+                auto expected = enumerateFinder.run(
+                        field, pieces, maxDepth, maxLine, holdEmpty, false, [](const Solution &) {}
+                );
+                auto count = finder.run(field, pieces, maxDepth, maxLine, holdEmpty);
+                EXPECT_EQ(count, expected);
+            }
+        }
+    }
+}
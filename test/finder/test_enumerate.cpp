@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include <set>
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/enumerate.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class EnumerateTest : public ::testing::Test {
+    };
+
+    TEST_F(EnumerateTest, case1) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = EnumerateFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "____XXXXXX"s +
+                "___XXXXXXX"s +
+                "__XXXXXXXX"s +
+                "___XXXXXXX"s +
+                ""
+        );
+        auto maxDepth = 3;
+        auto maxLine = 4;
+
+        {
+            auto pieces = std::vector{core::PieceType::S, core::PieceType::J, core::PieceType::I};
+            int calls = 0;
+            auto count = finder.run(field, pieces, maxDepth, maxLine, true, false, [&](const Solution &solution) {
+                EXPECT_EQ(solution.size(), 3);
+                calls += 1;
+            });
+            EXPECT_EQ(count, calls);
+            EXPECT_LT(0, count);
+        }
+
+        {
+            auto pieces = std::vector{core::PieceType::S, core::PieceType::L, core::PieceType::I};
+            auto count = finder.run(field, pieces, maxDepth, maxLine, true, false, [](const Solution &) {});
+            EXPECT_EQ(count, 0);
+        }
+    }
+
+    TEST_F(EnumerateTest, case2) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = EnumerateFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto maxDepth = 7;
+        auto maxLine = 6;
+
+        auto pieces = std::vector{
+                core::PieceType::J, core::PieceType::O, core::PieceType::T, core::PieceType::Z,
+                core::PieceType::S, core::PieceType::O, core::PieceType::L
+        };
+
+        std::set<SolutionWithKey> keys{};
+        auto all = finder.run(field, pieces, maxDepth, maxLine, false, false, [&](const Solution &solution) {
+            // Each solution is a perfect clear
+            auto freeze = core::Field(field);
+            for (const auto &operation : solution) {
+                freeze.put(factory.get(operation.pieceType, operation.rotateType), operation.x, operation.y);
+                freeze.clearLine();
+            }
+            EXPECT_EQ(freeze, core::Field());
+
+            keys.insert(toSortedSolutionWithKey(factory, field, solution));
+        });
+
+        int64_t unique = 0;
+        auto count = finder.run(field, pieces, maxDepth, maxLine, false, true, [&](const Solution &solution) {
+            EXPECT_EQ(keys.count(toSortedSolutionWithKey(factory, field, solution)), 1);
+            unique += 1;
+        });
+
+        EXPECT_EQ(count, unique);
+        EXPECT_EQ(unique, keys.size());
+        EXPECT_LT(unique, all);
+    }
+}
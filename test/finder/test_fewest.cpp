@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/fewest.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class FewestTest : public ::testing::Test {
+    };
+
+    TEST_F(FewestTest, getHeight) {
+        EXPECT_EQ(getHeight(core::Field()), 0);
+
+        auto field = core::createField(
+                "X_________"s +
+                "__________"s +
+                "XXXXXXXX__"s +
+                ""
+        );
+        EXPECT_EQ(getHeight(field), 3);
+        EXPECT_EQ(getNumOfAllBlocks(field), 9);
+    }
+
+    TEST_F(FewestTest, case1) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = FewestFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                ""
+        );
+
+        {
+            auto pieces = std::vector{
+                    core::PieceType::O, core::PieceType::O, core::PieceType::T, core::PieceType::L,
+                    core::PieceType::J, core::PieceType::S, core::PieceType::Z
+            };
+            auto result = finder.run(field, pieces, 7, 6, true);
+            EXPECT_EQ(result.depth, 2);
+            EXPECT_EQ(result.maxLine, 4);
+            EXPECT_EQ(result.solution.size(), 2);
+        }
+
+        {
+            auto pieces = std::vector{core::PieceType::T, core::PieceType::T};
+            auto result = finder.run(field, pieces, 2, 6, true);
+            EXPECT_EQ(result.depth, -1);
+            EXPECT_TRUE(result.solution.empty());
+        }
+    }
+
+    TEST_F(FewestTest, case2) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = FewestFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+
+        for (const auto &pieces : {
+                std::vector{
+                        core::PieceType::J, core::PieceType::I, core::PieceType::T, core::PieceType::Z,
+                        core::PieceType::S, core::PieceType::O, core::PieceType::L
+                },
+                std::vector{
+                        core::PieceType::J, core::PieceType::O, core::PieceType::T, core::PieceType::Z,
+                        core::PieceType::S, core::PieceType::O, core::PieceType::L
+                },
+        }) {
+            auto result = finder.run(field, pieces, 7, 6, false);
+            auto expected = perfectFinder.run(field, pieces, 7, 6, false);
+            if (expected.empty()) {
+                EXPECT_EQ(result.depth, -1);
+            } else {
+                EXPECT_EQ(result.depth, 7);
+                ASSERT_EQ(result.solution.size(), expected.size());
+                for (size_t index = 0; index < expected.size(); ++index) {
+                    EXPECT_EQ(result.solution[index].pieceType, expected[index].pieceType);
+                    EXPECT_EQ(result.solution[index].x, expected[index].x);
+                    EXPECT_EQ(result.solution[index].y, expected[index].y);
+                }
+            }
+        }
+    }
+}
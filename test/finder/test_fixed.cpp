@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/fixed.hpp"
+#include "finder/sequence_space.hpp"
+#include "perfect_clear.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class FixedRowsTest : public ::testing::Test {
+    };
+
+    TEST_F(FixedRowsTest, case1) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = FixedRowsFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXXX_"s +
+                "XXXXXXXXX_"s +
+                "XXXXXX____"s +
+                ""
+        );
+
+        // I clears the middle rows, then L is on the bottom
+        auto pieces = std::vector{core::PieceType::T, core::PieceType::I, core::PieceType::L};
+        auto solution = finder.run(field, pieces, 3, 4, true);
+        ASSERT_EQ(solution.size(), 2);
+        EXPECT_TRUE(isPerfectClear(factory, field, solution, 4));
+
+        EXPECT_TRUE(finder.run(field, std::vector{core::PieceType::T, core::PieceType::T}, 2, 4, true).empty());
+    }
+
+    TEST_F(FixedRowsTest, sameAsPerfectFinder) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto finder = FixedRowsFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        const int maxDepth = 7;
+        const int maxLine = 6;
+
+        auto prefix = Sequence{core::PieceType::O, core::PieceType::Z, core::PieceType::L};
+        auto bit = 0b1111111 & ~(1 << core::PieceType::O) & ~(1 << core::PieceType::Z) & ~(1 << core::PieceType::L);
+        auto space = SequenceSpace::createBag(prefix, maxDepth, bit);
+
+        space.forEach([&](int64_t, const Sequence &pieces) {
+            for (bool holdEmpty : {false, true}) {
+                auto expected = perfectFinder.run(field, pieces, maxDepth, maxLine, holdEmpty);
+                auto solution = finder.run(field, pieces, maxDepth, maxLine, holdEmpty);
+                EXPECT_EQ(solution.empty(), expected.empty());
+                if (!solution.empty()) {
+                    EXPECT_TRUE(isPerfectClear(factory, field, solution, maxLine));
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/mirror.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class MirrorTest : public ::testing::Test {
+    };
+
+    TEST_F(MirrorTest, operation) {
+        auto factory = core::Factory::create();
+
+        for (int piece = 0; piece < 7; ++piece) {
+            for (int rotate = 0; rotate < 4; ++rotate) {
+                auto pieceType = static_cast<core::PieceType>(piece);
+                auto rotateType = static_cast<core::RotateType>(rotate);
+                auto &blocks = factory.get(pieceType, rotateType);
+
+                for (int x = -blocks.minX; x < core::FIELD_WIDTH - blocks.maxX; ++x) {
+                    int y = 2 - blocks.minY;
+                    auto field = core::Field{};
+                    field.put(blocks, x, y);
+                    field.mirror();
+
+                    auto mirrored = mirror(factory, Operation{pieceType, rotateType, x, y});
+                    EXPECT_EQ(mirrored.pieceType, mirror(pieceType));
+                    EXPECT_NE(factory.get(mirrored.pieceType).uniqueRotateBit & (1 << mirrored.rotateType), 0);
+
+                    auto expected = core::Field{};
+                    expected.put(factory.get(mirrored.pieceType, mirrored.rotateType), mirrored.x, mirrored.y);
+                    EXPECT_EQ(field, expected);
+                }
+            }
+        }
+    }
+
+    TEST_F(MirrorTest, isMirrorSymmetric) {
+        for (const auto &factory : {core::Factory::create(), core::Factory::createForSSRPlus()}) {
+            EXPECT_TRUE(isMirrorSymmetric(factory, core::PieceType::T));
+            EXPECT_FALSE(isMirrorSymmetric(factory, core::PieceType::I));
+            EXPECT_TRUE(isMirrorSymmetric(factory, core::PieceType::L));
+            EXPECT_TRUE(isMirrorSymmetric(factory, core::PieceType::J));
+            EXPECT_TRUE(isMirrorSymmetric(factory, core::PieceType::S));
+            EXPECT_TRUE(isMirrorSymmetric(factory, core::PieceType::Z));
+            EXPECT_TRUE(isMirrorSymmetric(factory, core::PieceType::O));
+        }
+    }
+
+    TEST_F(MirrorTest, solution) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXX______"s +
+                "XXXX______"s +
+                "XXXX_____X"s +
+                "XXXXX___XX"s +
+                ""
+        );
+        auto pieces = std::vector<core::PieceType>{
+                core::PieceType::T, core::PieceType::S, core::PieceType::Z, core::PieceType::L, core::PieceType::J,
+        };
+
+        auto solution = finder.run(field, pieces, 5, 4, false);
+        ASSERT_FALSE(solution.empty());
+
+        // The mirrored solution clears the mirrored field
+        auto mirrorField = core::Field(field);
+        mirrorField.mirror();
+        auto mirrorSolution = mirror(factory, solution);
+
+        int leftLine = 4;
+        for (const auto &operation : mirrorSolution) {
+            auto &blocks = factory.get(operation.pieceType, operation.rotateType);
+            ASSERT_TRUE(mirrorField.canPut(blocks, operation.x, operation.y));
+            ASSERT_TRUE(mirrorField.isOnGround(blocks, operation.x, operation.y));
+            mirrorField.put(blocks, operation.x, operation.y);
+            leftLine -= mirrorField.clearLineReturnNum();
+        }
+        EXPECT_EQ(leftLine, 0);
+    }
+}
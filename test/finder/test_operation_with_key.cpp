@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+
+#include <unordered_set>
+
+#include "core/field.hpp"
+#include "finder/operation_with_key.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class OperationWithKeyTest : public ::testing::Test {
+    };
+
+    TEST_F(OperationWithKeyTest, sameForAllOrders) {
+        auto factory = core::Factory::create();
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                ""
+        );
+
+        auto lowerFirst = Solution{
+                Operation{core::PieceType::O, core::RotateType::Spawn, 8, 0},
+                Operation{core::PieceType::O, core::RotateType::Spawn, 8, 0},
+        };
+        auto upperFirst = Solution{
+                Operation{core::PieceType::O, core::RotateType::Spawn, 8, 2},
+                Operation{core::PieceType::O, core::RotateType::Spawn, 8, 0},
+        };
+        auto twice = Solution{
+                Operation{core::PieceType::O, core::RotateType::Spawn, 8, 2},
+                Operation{core::PieceType::O, core::RotateType::Spawn, 8, 2},
+        };
+
+        // The second O is at y=2 in the initial field
+        auto withKey = toSolutionWithKey(factory, field, lowerFirst);
+        ASSERT_EQ(withKey.size(), 2);
+        EXPECT_EQ(withKey[0], (OperationWithKey{core::PieceType::O, core::RotateType::Spawn, 8, 0, 0}));
+        EXPECT_EQ(withKey[1], (OperationWithKey{core::PieceType::O, core::RotateType::Spawn, 8, 2, 0}));
+
+        auto lowerKey = toSortedSolutionWithKey(factory, field, lowerFirst);
+        auto upperKey = toSortedSolutionWithKey(factory, field, upperFirst);
+        EXPECT_EQ(lowerKey, upperKey);
+        EXPECT_NE(lowerKey, toSortedSolutionWithKey(factory, field, twice));
+
+        auto hasher = SolutionWithKeyHasher{};
+        EXPECT_EQ(hasher(lowerKey), hasher(upperKey));
+
+        auto keys = std::unordered_set<SolutionWithKey, SolutionWithKeyHasher>{lowerKey};
+        EXPECT_EQ(keys.count(upperKey), 1);
+    }
+
+    TEST_F(OperationWithKeyTest, needDeletedKey) {
+        auto factory = core::Factory::create();
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXXX_"s +
+                "XXXXXXXXX_"s +
+                "XXXXXX____"s +
+                ""
+        );
+
+        // I clears the middle rows, then L is on the top and bottom rows
+        auto solution = Solution{
+                Operation{core::PieceType::I, core::RotateType::Right, 9, 2},
+                Operation{core::PieceType::L, core::RotateType::Spawn, 7, 0},
+        };
+
+        auto withKey = toSolutionWithKey(factory, field, solution);
+        ASSERT_EQ(withKey.size(), 2);
+
+        // Right of I is normalized to Left
+        EXPECT_EQ(withKey[0], (OperationWithKey{core::PieceType::I, core::RotateType::Left, 9, 1, 0}));
+
+        // Rows 1 and 2
+        EXPECT_EQ(withKey[1], (OperationWithKey{
+                core::PieceType::L, core::RotateType::Spawn, 7, 0, (1ULL << 10) | (1ULL << 20)
+        }));
+    }
+}
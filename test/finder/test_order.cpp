@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/pack.hpp"
+#include "finder/sequence_space.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class OrderTest : public ::testing::Test {
+    };
+
+    TEST_F(OrderTest, deletedRows) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXXX_"s +
+                "XXXXXXXXX_"s +
+                "XXXXXX____"s +
+                ""
+        );
+
+        auto sets = findPlacementSets(factory, field, 4);
+        ASSERT_EQ(sets.size(), 2);
+
+        // L on the top and bottom rows, and vertical I
+        auto &set = sets[1];
+        auto finder = OrderFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 4, set);
+
+        {
+            // I clears the middle rows, then L is on the bottom
+            auto solution = finder.run(std::vector{core::PieceType::I, core::PieceType::L}, true);
+            ASSERT_EQ(solution.size(), 2);
+            EXPECT_EQ(solution[0].pieceType, core::PieceType::I);
+            EXPECT_EQ(solution[0].y, 1);
+            EXPECT_EQ(solution[1].pieceType, core::PieceType::L);
+            EXPECT_EQ(solution[1].x, 7);
+            EXPECT_EQ(solution[1].y, 0);
+        }
+        {
+            // Hold L
+            auto solution = finder.run(std::vector{core::PieceType::L, core::PieceType::I}, true);
+            ASSERT_EQ(solution.size(), 2);
+            EXPECT_EQ(solution[0].pieceType, core::PieceType::I);
+        }
+        {
+            // L cannot be placed before I
+            auto solution = finder.run(std::vector{core::PieceType::L, core::PieceType::I}, false);
+            ASSERT_EQ(solution.size(), 2);
+            EXPECT_EQ(solution[0].pieceType, core::PieceType::I);
+        }
+
+        EXPECT_TRUE(finder.run(std::vector{core::PieceType::L, core::PieceType::T, core::PieceType::I}, true).empty());
+        EXPECT_TRUE(finder.run(std::vector{core::PieceType::L, core::PieceType::L}, true).empty());
+        EXPECT_TRUE(finder.run(std::vector{core::PieceType::I}, true).empty());
+    }
+
+    TEST_F(OrderTest, cacheIsShared) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+
+        auto sets = findPlacementSets(factory, field, 6);
+        ASSERT_LT(100, sets.size());
+
+        auto space = SequenceSpace::createPermutations(7);
+
+        for (size_t index = 0; index < sets.size(); index += sets.size() / 50) {
+            auto &set = sets[index];
+            auto shared = OrderFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 6, set);
+
+            for (int64_t value = 0; value < space.size(); value += 97) {
+                auto pieces = space.unrank(value);
+                auto fresh = OrderFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 6, set);
+                EXPECT_EQ(shared.run(pieces, false).size(), fresh.run(pieces, false).size());
+            }
+        }
+    }
+}
@@ -0,0 +1,253 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/pack.hpp"
+#include "finder/sequence_space.hpp"
+#include "perfect_clear.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class PackTest : public ::testing::Test {
+    };
+
+    namespace {
+        // Counts the searches to see whether the caches are hit
+        class CountingMoveGenerator {
+        public:
+            explicit CountingMoveGenerator(const core::Factory &factory) : moveGenerator(factory) {
+            }
+
+            void search(
+                    std::vector<core::Move> &moves, const core::Field &field, core::PieceType pieceType, int validHeight
+            ) {
+                searches += 1;
+                moveGenerator.search(moves, field, pieceType, validHeight);
+            }
+
+            int searches = 0;
+
+        private:
+            core::srs::MoveGenerator moveGenerator;
+        };
+    }
+
+    TEST_F(PackTest, findPlacementSets) {
+        auto factory = core::Factory::create();
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                "XXXXXXXX__"s +
+                ""
+        );
+
+        auto sets = findPlacementSets(factory, field, 4);
+        EXPECT_FALSE(sets.empty());
+
+        bool hasOO = false;
+        bool hasII = false;
+        for (const auto &set : sets) {
+            EXPECT_EQ(set.size(), 2);
+
+            core::Bitboard cells = 0;
+            for (const auto &placement : set) {
+                EXPECT_EQ(cells & placement.cells, 0);
+                cells |= placement.cells;
+            }
+            EXPECT_EQ(cells | field.getBoard(0), (1ULL << 40) - 1);
+
+            hasOO |= set[0].pieceType == core::PieceType::O && set[1].pieceType == core::PieceType::O;
+            hasII |= set[0].pieceType == core::PieceType::I && set[1].pieceType == core::PieceType::I;
+        }
+        EXPECT_TRUE(hasOO);
+        EXPECT_TRUE(hasII);
+    }
+
+    TEST_F(PackTest, deletedRows) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XXXXXXXX__"s +
+                "XXXXXXXXX_"s +
+                "XXXXXXXXX_"s +
+                "XXXXXX____"s +
+                ""
+        );
+
+        auto sets = findPlacementSets(factory, field, 4);
+        ASSERT_EQ(sets.size(), 2);
+
+        // L on the top and bottom rows, after the vertical I clears the middle rows
+        auto &set = sets[1];
+        ASSERT_EQ(set.size(), 2);
+        EXPECT_EQ(set[0].pieceType, core::PieceType::L);
+        EXPECT_EQ(set[0].usingRows, 0b1001);
+        EXPECT_EQ(set[0].deletedRows, 0b0110);
+        EXPECT_EQ(set[1].pieceType, core::PieceType::I);
+        EXPECT_EQ(set[1].deletedRows, 0);
+
+        auto finder = PackFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 4);
+
+        for (bool holdEmpty : {false, true}) {
+            for (const auto &pieces : std::vector<std::vector<core::PieceType>>{
+                    {core::PieceType::I, core::PieceType::L},
+                    {core::PieceType::L, core::PieceType::I},
+                    {core::PieceType::L, core::PieceType::L, core::PieceType::I},
+                    {core::PieceType::L, core::PieceType::T, core::PieceType::I},
+                    {core::PieceType::T, core::PieceType::T, core::PieceType::I},
+            }) {
+                auto solution = perfectFinder.run(field, pieces, 2, 4, holdEmpty);
+                auto result = finder.run(pieces, holdEmpty);
+                EXPECT_EQ(!result.empty(), !solution.empty());
+                if (!result.empty()) {
+                    EXPECT_TRUE(isPerfectClearOnGround(factory, field, result, 4));
+                }
+            }
+        }
+
+        EXPECT_FALSE(finder.run(std::vector{core::PieceType::I, core::PieceType::L}, true).empty());
+        EXPECT_FALSE(finder.run(std::vector{core::PieceType::L, core::PieceType::I}, true).empty());
+        EXPECT_TRUE(finder.run(std::vector{core::PieceType::T, core::PieceType::T, core::PieceType::I}, true).empty());
+        EXPECT_TRUE(finder.run(std::vector{core::PieceType::L, core::PieceType::L}, true).empty());
+    }
+
+    TEST_F(PackTest, sameAsPerfectFinder) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        const int maxDepth = 7;
+        const int maxLine = 6;
+
+        auto finder = PackFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, maxLine);
+
+        auto prefix = Sequence{core::PieceType::T, core::PieceType::I, core::PieceType::S};
+        auto bit = 0b1111111 & ~(1 << core::PieceType::T) & ~(1 << core::PieceType::I) & ~(1 << core::PieceType::S);
+        auto space = SequenceSpace::createBag(prefix, maxDepth, bit);
+
+        int success = 0;
+        space.forEach([&](int64_t, const Sequence &pieces) {
+            for (bool holdEmpty : {false, true}) {
+                auto solution = perfectFinder.run(field, pieces, maxDepth, maxLine, holdEmpty);
+                auto result = finder.run(pieces, holdEmpty);
+                EXPECT_EQ(!result.empty(), !solution.empty());
+                if (!result.empty()) {
+                    EXPECT_TRUE(isPerfectClearOnGround(factory, field, result, maxLine));
+                }
+                if (!solution.empty()) {
+                    success += 1;
+                }
+            }
+        });
+        EXPECT_LT(0, success);
+    }
+
+    TEST_F(PackTest, cacheIsShared) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = CountingMoveGenerator(factory);
+        auto freshGenerator = core::srs::MoveGenerator(factory);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+
+        auto finder = PackFinder<CountingMoveGenerator>(factory, moveGenerator, field, 6);
+        auto space = SequenceSpace::createPermutations(7);
+
+        std::vector<Sequence> queues{};
+        for (int64_t value = 0; value < space.size(); value += 997) {
+            queues.push_back(space.unrank(value));
+        }
+        ASSERT_LE(2, queues.size());
+
+        auto fresh = PackFinder<core::srs::MoveGenerator>(factory, freshGenerator, field, 6);
+
+        std::vector<bool> results{};
+        for (const auto &pieces : queues) {
+            auto result = finder.run(pieces, false);
+            EXPECT_EQ(result.empty(), fresh.run(pieces, false).empty());
+            results.push_back(result.empty());
+        }
+        EXPECT_LT(0, moveGenerator.searches);
+
+        // All reachable placements were checked by the first runs
+        int searches = moveGenerator.searches;
+        for (size_t index = 0; index < queues.size(); ++index) {
+            EXPECT_EQ(finder.run(queues[index], false).empty(), results[index]);
+        }
+        EXPECT_EQ(moveGenerator.searches, searches);
+    }
+
+    TEST_F(PackTest, emptyField) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+
+        // The sets that fill 4 empty lines are too many to be stored, so they are enumerated for each queue
+        auto field = core::Field{};
+        auto finder = PackFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 4);
+
+        auto pieces = Sequence{
+                core::PieceType::I, core::PieceType::O, core::PieceType::T, core::PieceType::S,
+                core::PieceType::Z, core::PieceType::L, core::PieceType::J, core::PieceType::I,
+                core::PieceType::O, core::PieceType::T, core::PieceType::S,
+        };
+        auto solution = finder.run(pieces, false);
+        ASSERT_EQ(solution.size(), 10u);
+        EXPECT_TRUE(isPerfectClear(factory, field, solution, 4));
+
+        // 8 pieces cannot fill the 36 cells left
+        field.setBlock(0, 0);
+        field.setBlock(1, 0);
+        field.setBlock(2, 0);
+        field.setBlock(3, 0);
+        auto filled = PackFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 4);
+        auto shortQueue = Sequence(pieces.begin(), pieces.begin() + 8);
+        EXPECT_TRUE(filled.run(shortQueue, false).empty());
+    }
+
+    TEST_F(PackTest, longtest1) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+
+        auto finder = PackFinder<core::srs::MoveGenerator>(factory, moveGenerator, field, 6);
+
+        int success = 0;
+        SequenceSpace::createPermutations(7).forEach([&](int64_t, const Sequence &pieces) {
+            if (!finder.run(pieces, false).empty()) {
+                success += 1;
+            }
+        });
+
+        EXPECT_EQ(success, 5038);
+    }
+}
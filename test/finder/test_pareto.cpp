@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/pareto.hpp"
+#include "perfect_clear.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class ParetoTest : public ::testing::Test {
+    };
+
+    TEST_F(ParetoTest, isBetterOrEqual) {
+        auto base = Record{kNoSolution, 1, 1, 2, 1, 2};
+        EXPECT_TRUE(isBetterOrEqual(base, base));
+        EXPECT_TRUE(isBetterOrEqual(base, Record{kNoSolution, 2, 1, 2, 1, 2}));
+        EXPECT_TRUE(isBetterOrEqual(base, Record{kNoSolution, 1, 1, 2, 1, 0}));
+        EXPECT_FALSE(isBetterOrEqual(base, Record{kNoSolution, 0, 1, 2, 1, 2}));
+        EXPECT_FALSE(isBetterOrEqual(base, Record{kNoSolution, 1, 1, 2, 2, 2}));
+    }
+
+    TEST_F(ParetoTest, archive) {
+        auto archive = ParetoArchive(2);
+
+        EXPECT_TRUE(archive.add(Record{kNoSolution, 1, 1, 2, 1, 0}));
+        EXPECT_FALSE(archive.add(Record{kNoSolution, 1, 1, 2, 1, 0}));
+        EXPECT_FALSE(archive.add(Record{kNoSolution, 2, 1, 2, 1, 0}));
+        EXPECT_TRUE(archive.add(Record{kNoSolution, 2, 0, 2, 1, 0}));
+        EXPECT_EQ(archive.get().size(), 2);
+        EXPECT_FALSE(archive.isOverflowed());
+
+        // Full
+        EXPECT_FALSE(archive.add(Record{kNoSolution, 3, 0, 1, 1, 0}));
+        EXPECT_TRUE(archive.isOverflowed());
+
+        // Dominates all
+        EXPECT_TRUE(archive.add(Record{kNoSolution, 0, 0, 1, 1, 0}));
+        EXPECT_EQ(archive.get().size(), 1);
+
+        archive.clear();
+        EXPECT_FALSE(archive.isOverflowed());
+    }
+
+    TEST_F(ParetoTest, capacity) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = ParetoFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto limited = ParetoFinder<core::srs::MoveGenerator>(factory, moveGenerator, 1);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto pieces = std::vector{
+                core::PieceType::J, core::PieceType::O, core::PieceType::T, core::PieceType::Z,
+                core::PieceType::S, core::PieceType::O, core::PieceType::L
+        };
+
+        auto records = finder.run(field, pieces, 7, 6, false);
+        EXPECT_FALSE(finder.isOverflowed());
+        ASSERT_LT(1u, records.size());
+
+        // The front does not fit in one record
+        EXPECT_EQ(limited.run(field, pieces, 7, 6, false).size(), 1u);
+        EXPECT_TRUE(limited.isOverflowed());
+    }
+
+    TEST_F(ParetoTest, case1) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = ParetoFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto maxDepth = 7;
+        auto maxLine = 6;
+
+        {
+            auto pieces = std::vector{
+                    core::PieceType::J, core::PieceType::O, core::PieceType::T, core::PieceType::Z,
+                    core::PieceType::S, core::PieceType::O, core::PieceType::L
+            };
+            auto records = finder.run(field, pieces, maxDepth, maxLine, false);
+            ASSERT_FALSE(records.empty());
+
+            for (const auto &record : records) {
+                EXPECT_TRUE(isPerfectClear(factory, field, record.solution, maxLine));
+
+                for (const auto &other : records) {
+                    if (&record != &other) {
+                        EXPECT_FALSE(isBetterOrEqual(other, record));
+                    }
+                }
+            }
+
+            // Contains the best of the default priority
+            auto best = perfectFinder.run(field, pieces, maxDepth, maxLine, false);
+            ASSERT_FALSE(best.empty());
+            // The default priority prefers T-Spin attack, then less softdrop
+            auto leastSoftdrop = std::min_element(records.begin(), records.end(), [](auto &lhs, auto &rhs) {
+                if (lhs.tSpinAttack != rhs.tSpinAttack) {
+                    return rhs.tSpinAttack < lhs.tSpinAttack;
+                }
+                return lhs.softdropCount < rhs.softdropCount;
+            });
+            int softdropCount = 0;
+            int leftLine = maxLine;
+            auto freeze = core::Field(field);
+            auto moves = std::vector<core::Move>{};
+            for (const auto &operation : best) {
+                moves.clear();
+                moveGenerator.search(moves, freeze, operation.pieceType, leftLine);
+                auto move = std::find_if(moves.begin(), moves.end(), [&](const core::Move &move) {
+                    return move.rotateType == operation.rotateType && move.x == operation.x && move.y == operation.y;
+                });
+                ASSERT_NE(move, moves.end());
+                softdropCount += move->harddrop ? 0 : 1;
+                freeze.put(factory.get(operation.pieceType, operation.rotateType), operation.x, operation.y);
+                leftLine -= freeze.clearLineReturnNum();
+                if (leftLine == 0) {
+                    break;
+                }
+            }
+            EXPECT_EQ(leastSoftdrop->softdropCount, softdropCount);
+        }
+
+        {
+            auto pieces = std::vector{
+                    core::PieceType::J, core::PieceType::I, core::PieceType::T, core::PieceType::Z,
+                    core::PieceType::S, core::PieceType::O, core::PieceType::L
+            };
+            auto records = finder.run(field, pieces, maxDepth, maxLine, false);
+            EXPECT_TRUE(records.empty());
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+
+#include "finder/path.hpp"
+#include "finder/perfect.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class SolutionInputsTest : public ::testing::Test {
+    };
+
+    TEST_F(SolutionInputsTest, toInputs) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto maxLine = 6;
+
+        auto pieces = std::vector{
+                core::PieceType::S, core::PieceType::J, core::PieceType::L, core::PieceType::Z,
+                core::PieceType::O, core::PieceType::I, core::PieceType::T
+        };
+
+        auto solution = finder.run(field, pieces, 7, maxLine, false);
+        ASSERT_FALSE(solution.empty());
+
+        auto inputs = toInputs(factory, field, solution, maxLine);
+        ASSERT_EQ(inputs.size(), solution.size());
+        for (const auto &operationInputs : inputs) {
+            ASSERT_FALSE(operationInputs.empty());
+            EXPECT_EQ(operationInputs.back(), core::Inputs::HardDrop);
+        }
+    }
+}
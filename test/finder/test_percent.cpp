@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+#include "core/field.hpp"
+#include "core/moves.hpp"
+#include "finder/percent.hpp"
+
+namespace finder {
+    using namespace std::literals::string_literals;
+
+    class PercentTest : public ::testing::Test {
+    };
+
+    TEST_F(PercentTest, sameAsPerfectFinder) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto finder = PercentFinder<core::srs::MoveGenerator>(factory, 2);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        const int maxDepth = 7;
+        const int maxLine = 6;
+
+        for (bool holdEmpty : {false, true}) {
+            // The prefix is the beginning of the first bag
+            auto prefix = Sequence{core::PieceType::J, core::PieceType::S, core::PieceType::T};
+            auto bit = 0b1111111 & ~(1 << core::PieceType::J) & ~(1 << core::PieceType::S) & ~(1 << core::PieceType::T);
+            auto sequences = std::vector<Sequence>{};
+            SequenceSpace::createBag(prefix, maxDepth, bit).forEach([&](int64_t, const Sequence &sequence) {
+                sequences.push_back(sequence);
+            });
+            auto result = finder.run(field, sequences, maxDepth, maxLine, holdEmpty);
+
+            int success = 0;
+            for (size_t index = 0; index < sequences.size(); ++index) {
+                auto solution = perfectFinder.run(field, sequences[index], maxDepth, maxLine, holdEmpty);
+                EXPECT_EQ(result.successes.test(static_cast<int>(index)), !solution.empty());
+                if (!solution.empty()) {
+                    success += 1;
+                }
+            }
+
+            EXPECT_EQ(result.total, 24);
+            EXPECT_EQ(result.success, success);
+            EXPECT_EQ(result.totalByFirst[core::PieceType::J], 24);
+            EXPECT_EQ(result.successByFirst[core::PieceType::J], success);
+            EXPECT_EQ(result.totalByFirst[core::PieceType::T], 0);
+        }
+    }
+
+    TEST_F(PercentTest, mirror) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto perfectFinder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto finder = PercentFinder<core::srs::MoveGenerator>(factory, 2);
+
+        // A symmetric field: the mirrored sequences without I are searched once
+        auto field = core::createField(
+                "XX______XX"s +
+                "XX______XX"s +
+                ""
+        );
+        const int maxDepth = 3;
+        const int maxLine = 2;
+
+        auto sequences = std::vector<Sequence>{};
+        SequenceSpace::createPermutations(maxDepth + 1).forEach([&](int64_t, const Sequence &sequence) {
+            sequences.push_back(sequence);
+        });
+        auto result = finder.run(field, sequences, maxDepth, maxLine, false);
+
+        int success = 0;
+        for (size_t index = 0; index < sequences.size(); ++index) {
+            auto solution = perfectFinder.run(field, sequences[index], maxDepth, maxLine, false);
+            EXPECT_EQ(result.successes.test(static_cast<int>(index)), !solution.empty());
+            if (!solution.empty()) {
+                success += 1;
+            }
+        }
+        EXPECT_EQ(result.success, success);
+        EXPECT_LT(0, success);
+    }
+
+    TEST_F(PercentTest, longtest1) {
+        auto factory = core::Factory::create();
+        auto finder = PercentFinder<core::srs::MoveGenerator>(factory);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+
+        auto space = SequenceSpace::createPermutations(7);
+        auto result = finder.run(field, space, 7, 6, false);
+
+        EXPECT_EQ(result.success, 5038);
+        EXPECT_EQ(result.total, 5040);
+        EXPECT_FALSE(result.successes.test(975));
+        EXPECT_FALSE(result.successes.test(2295));
+        EXPECT_EQ(result.successes.count(), 5038);
+
+        int sum = 0;
+        for (int count : result.successByFirst) {
+            sum += count;
+        }
+        EXPECT_EQ(sum, 5038);
+    }
+}
@@ -200,6 +200,115 @@ namespace finder {
         }
     }
 
+    TEST_F(PerfectTest, tSpinWithIterativeMoveGenerator) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto iterativeGenerator = core::srs_iterative::MoveGenerator(factory);
+        auto finder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto iterativeFinder = PerfectFinder<core::srs_iterative::MoveGenerator>(factory, iterativeGenerator);
+        auto classifier = core::srs_iterative::MoveGenerator(factory, true);
+        auto classifierFinder = PerfectFinder<core::srs_iterative::MoveGenerator>(factory, classifier);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto maxDepth = 7;
+        auto maxLine = 6;
+
+        // The priority prefers T-Spins first
+        auto pieces = std::vector{
+                core::PieceType::S, core::PieceType::J, core::PieceType::L, core::PieceType::Z,
+                core::PieceType::O, core::PieceType::I, core::PieceType::T
+        };
+
+        auto expected = finder.run(field, pieces, maxDepth, maxLine, false);
+        ASSERT_FALSE(expected.empty());
+
+        for (auto result : {
+                iterativeFinder.run(field, pieces, maxDepth, maxLine, false),
+                classifierFinder.run(field, pieces, maxDepth, maxLine, false),
+        }) {
+            ASSERT_EQ(result.size(), expected.size());
+            for (size_t index = 0; index < result.size(); ++index) {
+                EXPECT_EQ(result[index].pieceType, expected[index].pieceType);
+                EXPECT_EQ(result[index].rotateType, expected[index].rotateType);
+                EXPECT_EQ(result[index].x, expected[index].x);
+                EXPECT_EQ(result[index].y, expected[index].y);
+            }
+        }
+    }
+
+    TEST_F(PerfectTest, getAttackIfTSpinFromLastAction) {
+        auto factory = core::Factory::create();
+        auto reachable = core::srs_rotate_end::Reachable(factory);
+        auto classifier = core::srs_iterative::MoveGenerator(factory, true);
+
+        auto fields = std::vector<core::Field>{
+                core::createField(
+                        "XX________"s +
+                        "X___XXXXXX"s +
+                        "XX_XXXXXXX"s +
+                        ""
+                ),
+                core::createField(
+                        "________XX"s +
+                        "_________X"s +
+                        "XXXXXXXX_X"s +
+                        "XXXXXXX__X"s +
+                        "XXXXXXXX_X"s +
+                        ""
+                ),
+                core::createField(
+                        "_______XXX"s +
+                        "_________X"s +
+                        "________XX"s +
+                        "XXXXXX__XX"s +
+                        "XXXXXXX_XX"s +
+                        ""
+                ),
+                core::createField(
+                        "______XXXX"s +
+                        "________XX"s +
+                        "________XX"s +
+                        "XXXXXX__XX"s +
+                        "XXXXXXX_XX"s +
+                        ""
+                ),
+                core::createField(
+                        "XXXX______"s +
+                        "X_________"s +
+                        "XX________"s +
+                        "X__XXXXXXX"s +
+                        "XX_XXXXXXX"s +
+                        ""
+                ),
+        };
+
+        for (const auto &field : fields) {
+            auto moves = std::vector<core::Move>();
+            classifier.search(moves, field, core::PieceType::T, 24);
+
+            for (const auto &move : moves) {
+                auto freeze = core::Field(field);
+                freeze.put(factory.get(core::PieceType::T, move.rotateType), move.x, move.y);
+                int numCleared = freeze.clearLineReturnNum();
+
+                for (bool b2b : {false, true}) {
+                    EXPECT_EQ(
+                            getAttackIfTSpin(field, core::PieceType::T, move, numCleared, b2b),
+                            getAttackIfTSpin(reachable, factory, field, core::PieceType::T, move, numCleared, b2b)
+                    );
+                }
+            }
+        }
+    }
+
     // depth = 1 && piece = 1 && first hold is empty
     TEST_F(PerfectTest, case1) {
         auto factory = core::Factory::create();
@@ -438,6 +547,83 @@ namespace finder {
         }
     }
 
+    // Prefers the largest T-Spin attack and ignores all other counts
+    struct MostTSpinAttackOnly {
+        static bool shouldUpdate(const Record &oldRecord, const Record &newRecord) {
+            return oldRecord.tSpinAttack < newRecord.tSpinAttack;
+        }
+
+        static bool isWorseThanBest(const Record &best, const Candidate &current) {
+            return current.leftNumOfT == 0 && current.tSpinAttack <= best.tSpinAttack;
+        }
+    };
+
+    TEST_F(PerfectTest, priorityPolicy) {
+        auto factory = core::Factory::create();
+        auto moveGenerator = core::srs::MoveGenerator(factory);
+        auto finder = PerfectFinder<core::srs::MoveGenerator>(factory, moveGenerator);
+        auto comboFinder = PerfectFinder<core::srs::MoveGenerator, MostComboPriority>(factory, moveGenerator);
+        auto tSpinFinder = PerfectFinder<core::srs::MoveGenerator, MostTSpinAttackOnly>(factory, moveGenerator);
+
+        auto field = core::createField(
+                "XX________"s +
+                "XX________"s +
+                "XXX______X"s +
+                "XXXXXXX__X"s +
+                "XXXXXX___X"s +
+                "XXXXXXX_XX"s +
+                ""
+        );
+        auto maxDepth = 7;
+        auto maxLine = 6;
+
+        auto pieces = std::vector{
+                core::PieceType::S, core::PieceType::J, core::PieceType::L, core::PieceType::Z,
+                core::PieceType::O, core::PieceType::I, core::PieceType::T
+        };
+
+        {
+            auto expected = finder.run(field, pieces, maxDepth, maxLine, false, true, 0);
+            auto result = finder.run(field, pieces, maxDepth, maxLine, false);
+            ASSERT_EQ(result.size(), expected.size());
+            for (size_t index = 0; index < result.size(); ++index) {
+                EXPECT_EQ(result[index].pieceType, expected[index].pieceType);
+                EXPECT_EQ(result[index].rotateType, expected[index].rotateType);
+                EXPECT_EQ(result[index].x, expected[index].x);
+                EXPECT_EQ(result[index].y, expected[index].y);
+            }
+        }
+
+        {
+            auto expected = finder.run(field, pieces, maxDepth, maxLine, false, false, 0);
+            auto result = comboFinder.run(field, pieces, maxDepth, maxLine, false);
+            ASSERT_EQ(result.size(), expected.size());
+            for (size_t index = 0; index < result.size(); ++index) {
+                EXPECT_EQ(result[index].pieceType, expected[index].pieceType);
+                EXPECT_EQ(result[index].rotateType, expected[index].rotateType);
+                EXPECT_EQ(result[index].x, expected[index].x);
+                EXPECT_EQ(result[index].y, expected[index].y);
+            }
+        }
+
+        {
+            auto expected = finder.run(field, pieces, maxDepth, maxLine, false, false, 3);
+            auto result = comboFinder.runWithInitCombo(field, pieces, maxDepth, maxLine, false, 3);
+            ASSERT_EQ(result.size(), expected.size());
+            for (size_t index = 0; index < result.size(); ++index) {
+                EXPECT_EQ(result[index].pieceType, expected[index].pieceType);
+                EXPECT_EQ(result[index].rotateType, expected[index].rotateType);
+                EXPECT_EQ(result[index].x, expected[index].x);
+                EXPECT_EQ(result[index].y, expected[index].y);
+            }
+        }
+
+        {
+            auto result = tSpinFinder.run(field, pieces, maxDepth, maxLine, false);
+            EXPECT_FALSE(result.empty());
+        }
+    }
+
     template<int N>
     std::array<core::PieceType, N> toPieces(int value) {
         int arr[N];
@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+
+#include "finder/sequence_set.hpp"
+
+namespace finder {
+    class SequenceSetTest : public ::testing::Test {
+    };
+
+    TEST_F(SequenceSetTest, operations) {
+        auto even = SequenceSet(5040);
+        auto three = SequenceSet(5040);
+        for (int index = 0; index < 5040; ++index) {
+            if (index % 2 == 0) {
+                even.set(index);
+            }
+            if (index % 3 == 0) {
+                three.set(index);
+            }
+        }
+
+        EXPECT_EQ(even.size(), 5040);
+        EXPECT_EQ(even.count(), 2520);
+        EXPECT_EQ(three.count(), 1680);
+        EXPECT_EQ(even.countAnd(three), 840);
+        EXPECT_EQ((even & three).count(), 840);
+        EXPECT_EQ((even | three).count(), 2520 + 1680 - 840);
+        EXPECT_TRUE((even & three).test(5034));
+        EXPECT_FALSE((even & three).test(5038));
+
+        auto set = SequenceSet(even);
+        set |= three;
+        EXPECT_EQ(set, even | three);
+        set &= three;
+        EXPECT_EQ(set, three);
+        EXPECT_NE(set, even);
+
+        set.reset(0);
+        EXPECT_FALSE(set.test(0));
+        EXPECT_EQ(set.count(), 1679);
+    }
+}
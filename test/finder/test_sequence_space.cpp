@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include <array>
+
+#include "finder/sequence_space.hpp"
+
+namespace finder {
+    class SequenceSpaceTest : public ::testing::Test {
+    };
+
+    template<int N>
+    std::array<core::PieceType, N> toPieces(int value) {
+        int arr[N];
+
+        for (int index = N - 1; 0 <= index; --index) {
+            int scale = 7 - index;
+            arr[index] = value % scale;
+            value /= scale;
+        }
+
+        for (int select = N - 2; 0 <= select; --select) {
+            for (int adjust = select + 1; adjust < N; ++adjust) {
+                if (arr[select] <= arr[adjust]) {
+                    arr[adjust] += 1;
+                }
+            }
+        }
+
+        std::array<core::PieceType, N> pieces = {};
+        for (int index = 0; index < N; ++index) {
+            pieces[index] = static_cast<core::PieceType>(arr[index]);
+        }
+
+        return pieces;
+    }
+
+    // Checks that the space enumerates sorted, distinct sequences and that rank and unrank agree
+    void verify(const SequenceSpace &space) {
+        auto previous = Sequence{};
+        int64_t count = 0;
+        space.forEach([&](int64_t index, const Sequence &sequence) {
+            EXPECT_EQ(index, count);
+            EXPECT_EQ(static_cast<int>(sequence.size()), space.length());
+            if (0 < index) {
+                EXPECT_LT(previous, sequence);
+            }
+            EXPECT_EQ(space.unrank(index), sequence);
+            EXPECT_EQ(space.rank(sequence), index);
+            previous = sequence;
+            count += 1;
+        });
+        EXPECT_EQ(count, space.size());
+    }
+
+    TEST_F(SequenceSpaceTest, permutations) {
+        {
+            auto space = SequenceSpace::createPermutations(7);
+            EXPECT_EQ(space.size(), 5040);
+            EXPECT_EQ(space.length(), 7);
+            verify(space);
+
+            for (int index = 0; index < 5040; ++index) {
+                auto arr = toPieces<7>(index);
+                EXPECT_EQ(space.unrank(index), Sequence(arr.begin(), arr.end()));
+            }
+        }
+        {
+            auto space = SequenceSpace::createPermutations(4);
+            EXPECT_EQ(space.size(), 840);
+            verify(space);
+
+            for (int index = 0; index < 840; ++index) {
+                auto arr = toPieces<4>(index);
+                EXPECT_EQ(space.unrank(index), Sequence(arr.begin(), arr.end()));
+            }
+        }
+        {
+            auto space = SequenceSpace::createPermutations(0);
+            EXPECT_EQ(space.size(), 1);
+            EXPECT_TRUE(space.unrank(0).empty());
+        }
+    }
+
+    TEST_F(SequenceSpaceTest, bag) {
+        {
+            // The next bag starts after 7 pieces
+            auto space = SequenceSpace::createBag(Sequence{}, 9);
+            EXPECT_EQ(space.size(), 5040 * 7 * 6);
+            EXPECT_EQ(space.unrank(0), (Sequence{
+                    core::PieceType::T, core::PieceType::I, core::PieceType::L, core::PieceType::J,
+                    core::PieceType::S, core::PieceType::Z, core::PieceType::O, core::PieceType::T, core::PieceType::I,
+            }));
+            EXPECT_EQ(space.unrank(space.size() - 1), (Sequence{
+                    core::PieceType::O, core::PieceType::Z, core::PieceType::S, core::PieceType::J,
+                    core::PieceType::L, core::PieceType::I, core::PieceType::T, core::PieceType::O, core::PieceType::Z,
+            }));
+        }
+        {
+            auto prefix = Sequence{core::PieceType::I, core::PieceType::I};
+            auto bit = (1 << core::PieceType::T) | (1 << core::PieceType::O);
+            auto space = SequenceSpace::createBag(prefix, 6, bit);
+            EXPECT_EQ(space.size(), 2 * 7 * 6);
+            EXPECT_EQ(space.unrank(0), (Sequence{
+                    core::PieceType::I, core::PieceType::I, core::PieceType::T, core::PieceType::O,
+                    core::PieceType::T, core::PieceType::I,
+            }));
+            verify(space);
+        }
+    }
+
+    TEST_F(SequenceSpaceTest, repetition) {
+        auto prefix = Sequence{core::PieceType::Z};
+        auto space = SequenceSpace::createRepetition(prefix, 4);
+        EXPECT_EQ(space.size(), 343);
+        EXPECT_EQ(space.unrank(8), (Sequence{
+                core::PieceType::Z, core::PieceType::T, core::PieceType::I, core::PieceType::I,
+        }));
+        verify(space);
+    }
+
+    TEST_F(SequenceSpaceTest, chunks) {
+        auto space = SequenceSpace::createPermutations(7);
+
+        int64_t next = 0;
+        for (int chunkIndex = 0; chunkIndex < 11; ++chunkIndex) {
+            auto chunk = space.getChunk(chunkIndex, 11);
+            EXPECT_EQ(chunk.begin, next);
+
+            // 5040 = 458 * 11 + 2
+            EXPECT_EQ(chunk.end - chunk.begin, chunkIndex < 2 ? 459 : 458);
+
+            int64_t count = 0;
+            space.forEach(chunk, [&](int64_t index, const Sequence &sequence) {
+                EXPECT_EQ(space.unrank(index), sequence);
+                count += 1;
+            });
+            EXPECT_EQ(count, chunk.end - chunk.begin);
+
+            next = chunk.end;
+        }
+        EXPECT_EQ(next, 5040);
+    }
+}